@@ -40,7 +40,7 @@ OutputIterator adjacent_difference(ExecutionPolicy &sep, Iterator b, Iterator e,
             }
           });
     };
-    q.submit(f).wait();
+    sep.complete(q.submit(f));
     return out + n;
   }
 }
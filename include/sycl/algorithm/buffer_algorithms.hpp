@@ -30,18 +30,75 @@
 #define __SYCL_IMPL_BUFFER_ALGORITHM__
 
 #include <sycl/helpers/sycl_buffers.hpp>
+#include <sycl/helpers/sycl_device_future.hpp>
+#include <sycl/helpers/sycl_device_properties.hpp>
+#include <sycl/helpers/sycl_tuning_cache.hpp>
 #include <sycl/helpers/sycl_namegen.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <string>
+#include <typeinfo>
+#include <vector>
 
 namespace sycl {
 namespace impl {
 
 
+/*
+ * make_temp_device_pointer slots used by the reductions and scans, apart from
+ * the small ones used by the algorithms built on top of them
+ */
+constexpr int mapreduce_partials_order = 16;
+constexpr int mapreduce_counter_order = 17;
+constexpr int mapreduce_result_order = 18;
+constexpr int find_first_state_order = 19;
+constexpr int global_scan_totals_order = 24;
+
+/*
+ * Number of positions tested by each work item in one chunk of
+ * buffer_find_first
+ */
+constexpr size_t find_first_items_per_work_item = 16;
+
 inline size_t up_rounded_division(size_t x, size_t y){
   return (x+(y-1)) / y;
 }
 
+inline size_t round_down_power_of_two(size_t x) {
+  size_t p = 1;
+  while (p <= x / 2)
+    p <<= 1;
+  return p;
+}
+
+inline size_t round_up_power_of_two(size_t x) {
+  size_t p = 1;
+  while (p < x)
+    p <<= 1;
+  return p;
+}
+
+/*
+ * Maximum number of work items in a 1D work group on this device
+ */
+inline size_t max_work_item_count(cl::sycl::device device) {
+  return sycl::helpers::get_device_properties(device).max_work_item;
+}
+
+/*
+ * Maximum number of work items in a 1D work group on this device when each of
+ * them keeps a value of ``sizeofB`` bytes in local memory, 0 when a single
+ * value does not fit
+ */
+inline size_t max_local_work_item_count(cl::sycl::device device,
+                                        size_t sizeofB) {
+  const auto &properties = sycl::helpers::get_device_properties(device);
+  return std::min(properties.max_work_item,
+                  properties.local_mem_size / sizeofB);
+}
+
 
 struct sycl_algorithm_descriptor {
   size_t size,
@@ -51,7 +108,11 @@ struct sycl_algorithm_descriptor {
          nb_work_item;
   sycl_algorithm_descriptor() = default;
   sycl_algorithm_descriptor(size_t size_):
-    size(size_) {}
+    size(size_),
+    size_per_work_group(0),
+    size_per_work_item(0),
+    nb_work_group(0),
+    nb_work_item(0) {}
   sycl_algorithm_descriptor(size_t size_,
                        size_t size_per_work_group_,
                        size_t size_per_work_item_,
@@ -64,6 +125,127 @@ struct sycl_algorithm_descriptor {
     nb_work_item(nb_work_item_) {}
 };
 
+/*
+ * Reduces the first ``count`` values of the local memory ``scratch`` into
+ * ``scratch[0]`` with a log-depth tree instead of a serial loop on the first
+ * work item. Every work item of the group has to call it with the same
+ * ``count``, which must not exceed the work group size.
+ */
+template <typename LocalAccessor, typename Reduce>
+void local_tree_reduce(const cl::sycl::nd_item<1> &nd_item,
+                       const LocalAccessor &scratch,
+                       size_t count,
+                       Reduce reduce) {
+  const size_t local_id = nd_item.get_local_id(0);
+  for (size_t offset = round_up_power_of_two(count) >> 1;
+       offset > 0;
+       offset >>= 1) {
+    if (local_id < offset && local_id + offset < count) {
+      scratch[local_id] = reduce(scratch[local_id], scratch[local_id + offset]);
+    }
+    nd_item.barrier(cl::sycl::access::fence_space::local_space);
+  }
+}
+
+/*
+ * Final step of buffer_mapreduce and buffer_map2reduce, called by every work
+ * item once ``sum[0]`` holds the partial result of its work group.
+ * The partial is stored in ``partials`` and the last work group to finish,
+ * detected with ``counter``, folds all of them with ``init`` into ``*result``,
+ * so the reduction completes on the device without reading the partials back.
+ */
+template <typename LocalAccessor, typename FlagAccessor, typename B,
+          typename Reduce>
+void combine_partials_on_last_group(const cl::sycl::nd_item<1> &nd_item,
+                                    const LocalAccessor &sum,
+                                    const FlagAccessor &is_last,
+                                    B *partials,
+                                    unsigned int *counter,
+                                    size_t nb_work_group,
+                                    B init,
+                                    Reduce reduce,
+                                    B *result) {
+  using counter_ref =
+      cl::sycl::atomic_ref<unsigned int, cl::sycl::memory_order::acq_rel,
+                           cl::sycl::memory_scope::device,
+                           cl::sycl::access::address_space::global_space>;
+  const size_t local_id = nd_item.get_local_id(0);
+  const size_t nb_work_item = nd_item.get_local_range(0);
+
+  if (local_id == 0) {
+    partials[nd_item.get_group(0)] = sum[0];
+    cl::sycl::atomic_fence(cl::sycl::memory_order::release,
+                           cl::sycl::memory_scope::device);
+    is_last[0] = (counter_ref(*counter).fetch_add(1u) + 1 == nb_work_group);
+  }
+  nd_item.barrier(cl::sycl::access::fence_space::global_and_local);
+
+  if (!is_last[0])
+    return;
+
+  cl::sycl::atomic_fence(cl::sycl::memory_order::acquire,
+                         cl::sycl::memory_scope::device);
+  if (local_id < nb_work_group) {
+    B acc = partials[local_id];
+    for (size_t pos = local_id + nb_work_item;
+         pos < nb_work_group;
+         pos += nb_work_item) {
+      acc = reduce(acc, partials[pos]);
+    }
+    sum[local_id] = acc;
+  }
+  nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+  local_tree_reduce(nd_item, sum, std::min(nb_work_item, nb_work_group), reduce);
+
+  if (local_id == 0) {
+    *result = reduce(init, sum[0]);
+  }
+}
+
+/*
+ * Descriptor of a reduction of ``size`` elements using work groups of
+ * ``nb_work_item`` work items and at most ``max_work_group`` work groups
+ */
+inline
+sycl_algorithm_descriptor make_mapreduce_descriptor(size_t size,
+                                                    size_t nb_work_item,
+                                                    size_t max_work_group) {
+  using std::max;
+  using std::min;
+  // we ensure that each work_item of every work_group is used at least once
+  size_t nb_work_group = min(max_work_group,
+                             up_rounded_division(size, nb_work_item));
+
+  //assert(nb_work_group >= 1);
+
+  //number of elements manipulated by each work_item
+  size_t size_per_work_item =
+    up_rounded_division(size, nb_work_item * nb_work_group);
+
+  //number of elements manipulated by each work_group (except the last one)
+  size_t size_per_work_group = size_per_work_item * nb_work_item;
+
+
+  nb_work_group = max(static_cast<size_t>(1),
+                      up_rounded_division(size, size_per_work_group));
+
+  //assert(nb_work_group >= 1);
+
+  //assert(size_per_work_group * (nb_work_group - 1) < size);
+  //assert(size_per_work_group * nb_work_group >= size);
+  /* number of elements manipulated by the last work_group
+   * n.b. if the value is 0, the last work_group is regular
+   */
+
+  return sycl_algorithm_descriptor {
+    size,
+    size_per_work_group,
+    size_per_work_item,
+    nb_work_group,
+    nb_work_item };
+}
+
 /*
  * Compute a valid set of parameters for buffer_mapreduce algorithm to
  * work properly
@@ -85,23 +267,13 @@ sycl_algorithm_descriptor compute_mapreduce_descriptor(cl::sycl::device device,
        local_mem_size
    *  - every work group do something
    */
-  size_t max_work_group =
-    device.get_info<cl::sycl::info::device::max_compute_units>();
-
-  const cl::sycl::id<3> max_work_item_sizes =
-    device.get_info<
-#if defined(__COMPUTECPP__)
-      cl::sycl::info::device::max_work_item_sizes
-#else
-      cl::sycl::info::device::max_work_item_sizes<3>
-#endif
-    >();
-  const auto max_work_item = min(
-    device.get_info<cl::sycl::info::device::max_work_group_size>(),
-    max_work_item_sizes[0]);
-
-  size_t local_mem_size =
-    device.get_info<cl::sycl::info::device::local_mem_size>();
+  const auto &properties = sycl::helpers::get_device_properties(device);
+
+  size_t max_work_group = properties.max_compute_units;
+
+  const auto max_work_item = properties.max_work_item;
+
+  size_t local_mem_size = properties.local_mem_size;
 
   size_t nb_work_item = min(min(max_work_item, local_mem_size / sizeofB), size);
 
@@ -113,37 +285,172 @@ sycl_algorithm_descriptor compute_mapreduce_descriptor(cl::sycl::device device,
   if (nb_work_item == 0) {
     return sycl_algorithm_descriptor { size };
   }
-  // we ensure that each work_item of every work_group is used at least once
-  size_t nb_work_group = min(max_work_group,
-                             up_rounded_division(size, nb_work_item));
-
-  //assert(nb_work_group >= 1);
+  return make_mapreduce_descriptor(size, nb_work_item, max_work_group);
+}
 
-  //number of elements manipulated by each work_item
-  size_t size_per_work_item =
-    up_rounded_division(size, nb_work_item * nb_work_group);
+/*
+ * Autotuned descriptor of a reduction, see sycl::helpers::tuning_cache.
+ * Returns ``d`` unchanged unless autotuning is enabled. Otherwise the launch
+ * geometry is taken from the tuning cache, or chosen by timing ``run(d)``, a
+ * synchronous run of the reduction, for a few work group sizes and counts.
+ * Only reductions are tuned, as running them several times has no side
+ * effect.
+ */
+template <typename Run>
+sycl_algorithm_descriptor tuned_mapreduce_descriptor(cl::sycl::queue q,
+                                                     const std::string &algorithm,
+                                                     size_t sizeofB,
+                                                     sycl_algorithm_descriptor d,
+                                                     Run run) {
+  using std::min;
+  auto &cache = sycl::helpers::tuning_cache::instance();
+  if (cache.get_mode() == sycl::helpers::tuning_cache::mode::off ||
+      (d.nb_work_item == 0) || (d.nb_work_group == 0)) {
+    return d;
+  }
+  const auto device = q.get_device();
+  const auto &properties = sycl::helpers::get_device_properties(device);
+  const size_t max_work_item =
+    min(min(properties.max_work_item, properties.local_mem_size / sizeofB),
+        d.size);
+  const std::string key =
+    sycl::helpers::tuning_cache::make_key(algorithm, sizeofB, properties.name,
+                                          d.size);
+
+  sycl::helpers::tuned_launch best;
+  if (!cache.find(key, best)) {
+    using clock = std::chrono::steady_clock;
+    auto best_time = clock::duration::max();
+    best = { d.nb_work_item, properties.max_compute_units };
+    for (size_t nb_work_item = max_work_item; nb_work_item > 0;
+         nb_work_item = (nb_work_item >= 64) ? nb_work_item / 2 : 0) {
+      for (size_t groups_per_unit : { 1, 2, 4, 8 }) {
+        const size_t max_work_group =
+          properties.max_compute_units * groups_per_unit;
+        const auto candidate =
+          make_mapreduce_descriptor(d.size, nb_work_item, max_work_group);
+        // the first run warms up, the best of the next ones is kept
+        run(candidate);
+        auto time = clock::duration::max();
+        for (int repeat = 0; repeat < 3; repeat++) {
+          const auto start = clock::now();
+          run(candidate);
+          time = min(time, clock::now() - start);
+        }
+        if (time < best_time) {
+          best_time = time;
+          best = { nb_work_item, max_work_group };
+        }
+        if (candidate.nb_work_group < max_work_group) {
+          // more groups than elements need, the next counts are the same
+          break;
+        }
+      }
+    }
+    cache.store(key, best);
+  }
+  return make_mapreduce_descriptor(
+    d.size, min(best.nb_work_item, max_work_item), best.nb_work_group);
+}
 
-  //number of elements manipulated by each work_group (except the last one)
-  size_t size_per_work_group = size_per_work_item * nb_work_item;
+/*
+ * Reduction for accumulators too large for local memory, the descriptors of
+ * which have no work item: every work item reduces a contiguous chunk into
+ * global scratch memory, then the partials are combined by a tree of kernels,
+ * each work item reducing global_reduce_fan_in consecutive partials of the
+ * previous level, until a single one is left.
+ * ``load(pos)`` returns the mapped value at ``pos``, and ``scratch`` holds
+ * 2 * global_reduce_partial_count(device, size) values.
+ */
+constexpr size_t global_reduce_fan_in = 8;
 
+inline size_t global_reduce_partial_count(cl::sycl::device device,
+                                          size_t size) {
+  const auto &properties = sycl::helpers::get_device_properties(device);
+  return std::max<size_t>(1, std::min(size, properties.max_work_item *
+                                              properties.max_compute_units));
+}
 
-  nb_work_group = max(static_cast<size_t>(1),
-                      up_rounded_division(size, size_per_work_group));
+/*
+ * Submits a kernel running ``f(id)`` for every id of [0, count), after the
+ * ``dependencies``
+ */
+template <typename F>
+cl::sycl::event submit_global_range(
+    cl::sycl::queue q, size_t count, F f,
+    const std::vector<cl::sycl::event> &dependencies = {}) {
+  const size_t nb_work_item = std::min(max_work_item_count(q.get_device()),
+                                       count);
+  return q.submit([&] (cl::sycl::handler &cgh) {
+    cgh.depends_on(dependencies);
+    cl::sycl::range<1> rg { up_rounded_division(count, nb_work_item) };
+    cl::sycl::range<1> ri { nb_work_item };
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                     [=](cl::sycl::nd_item<1> nd_item) {
+      const size_t id = nd_item.get_global_id(0);
+      if (id < count)
+        f(id);
+    });
+  });
+}
 
-  //assert(nb_work_group >= 1);
+template <typename B, typename Load, typename Reduce>
+cl::sycl::event buffer_global_reduce(cl::sycl::queue q,
+                                     size_t size,
+                                     B init,
+                                     Load load,
+                                     Reduce reduce,
+                                     B *result,
+                                     B *scratch) {
+  using std::min;
+  if (size == 0) {
+    return submit_global_range(q, 1, [=](size_t) { *result = init; });
+  }
+  const size_t nb_partials = global_reduce_partial_count(q.get_device(), size);
+  const size_t chunk = up_rounded_division(size, nb_partials);
+  size_t count = up_rounded_division(size, chunk);
+  B *partials = scratch;
+  B *next = scratch + nb_partials;
+
+  // the levels are chained by their events, so that the asynchronous
+  // reductions do not block
+  cl::sycl::event level = submit_global_range(q, count, [=](size_t id) {
+    const size_t begin = id * chunk;
+    const size_t end = min(begin + chunk, size);
+    B acc = load(begin);
+    for (size_t pos = begin + 1; pos < end; pos++)
+      acc = reduce(acc, load(pos));
+    partials[id] = acc;
+  });
+
+  while (count > 1) {
+    const size_t next_count = up_rounded_division(count, global_reduce_fan_in);
+    level = submit_global_range(q, next_count, [=](size_t id) {
+      const size_t begin = id * global_reduce_fan_in;
+      const size_t end = min(begin + global_reduce_fan_in, count);
+      B acc = partials[begin];
+      for (size_t pos = begin + 1; pos < end; pos++)
+        acc = reduce(acc, partials[pos]);
+      next[id] = acc;
+    }, {level});
+    std::swap(partials, next);
+    count = next_count;
+  }
 
-  //assert(size_per_work_group * (nb_work_group - 1) < size);
-  //assert(size_per_work_group * nb_work_group >= size);
-  /* number of elements manipulated by the last work_group
-   * n.b. if the value is 0, the last work_group is regular
-   */
+  return submit_global_range(q, 1, [=](size_t) {
+    *result = reduce(init, partials[0]);
+  }, {level});
+}
 
-  return sycl_algorithm_descriptor {
-    size,
-    size_per_work_group,
-    size_per_work_item,
-    nb_work_group,
-    nb_work_item };
+/*
+ * Number of values in the ``partials`` of buffer_mapreduce_to_device and
+ * buffer_map2reduce_to_device
+ */
+inline size_t mapreduce_partials_count(cl::sycl::device device,
+                                       const sycl_algorithm_descriptor &d) {
+  if ((d.nb_work_item == 0) || (d.nb_work_group == 0))
+    return 2 * global_reduce_partial_count(device, d.size);
+  return d.nb_work_group;
 }
 
 /*
@@ -159,13 +466,16 @@ template <typename ExecutionPolicy,
           typename B,
           typename Reduce,
           typename Map>
-B buffer_mapreduce(ExecutionPolicy &snp,
-                   cl::sycl::queue q,
-                   InputIterator input_iter,
-                   B init, //map is not applied on init
-                   sycl_algorithm_descriptor d,
-                   Map map,
-                   Reduce reduce) {
+cl::sycl::event buffer_mapreduce_to_device(ExecutionPolicy &snp,
+                                           cl::sycl::queue q,
+                                           InputIterator input_iter,
+                                           B init, //map is not applied on init
+                                           sycl_algorithm_descriptor d,
+                                           Map map,
+                                           Reduce reduce,
+                                           B *result,
+                                           B *partials = nullptr,
+                                           unsigned int *counter = nullptr) {
   typedef typename std::iterator_traits<InputIterator>::value_type A;
 
   /*
@@ -175,30 +485,42 @@ B buffer_mapreduce(ExecutionPolicy &snp,
    */
 
   if ((d.nb_work_item == 0) || (d.nb_work_group == 0)) {
+    if (partials == nullptr) {
+      partials = sycl::helpers::make_temp_device_pointer<
+        B, mapreduce_partials_order>(mapreduce_partials_count(q.get_device(), d), q);
+    }
     auto read_input = input_iter;
-    B acc = init;
-    for (size_t pos = 0; pos < d.size; pos++)
-      acc = reduce(acc, map(pos, read_input[pos]));
-
-    return acc;
+    return buffer_global_reduce(
+      q, d.size, init,
+      [=](size_t pos) { return map(pos, read_input[pos]); },
+      reduce, result, partials);
   }
 
   using std::min;
   using std::max;
 
-  // reuse temporary buffer between function calls
-  // cl::sycl::buffer<B, 1> output_buff { cl::sycl::range<1> { d.nb_work_group } };
-  cl::sycl::buffer<B, 1>& output_buff = sycl::helpers::make_temp_buffer<B>(d.nb_work_group);
+  // reuse temporary memory between function calls unless the caller gave some
+  if (partials == nullptr) {
+    partials = sycl::helpers::make_temp_device_pointer<
+      B, mapreduce_partials_order>(d.nb_work_group, q);
+  }
+  if (counter == nullptr) {
+    counter = sycl::helpers::make_temp_device_pointer<
+      unsigned int, mapreduce_counter_order>(1, q);
+  }
+  auto reset = q.fill(counter, 0u, 1);
 
-  q.submit([&] (cl::sycl::handler &cgh) {
+  return q.submit([&] (cl::sycl::handler &cgh) {
+    cgh.depends_on(reset);
     cl::sycl::range<1> rg { d.nb_work_group };
     cl::sycl::range<1> ri { d.nb_work_item };
     auto input = input_iter;
-    auto output = output_buff.template get_access
-      <cl::sycl::access::mode::write>(cgh);
     cl::sycl::accessor<B, 1, cl::sycl::access::mode::read_write,
                        cl::sycl::access::target::local>
       sum { cl::sycl::range<1>(d.nb_work_item), cgh };
+    cl::sycl::accessor<int, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+      is_last { cl::sycl::range<1>(1), cgh };
     cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri), [=](cl::sycl::nd_item<1> nd_item) {
       // hierarchical parallelism is changing, so avoid using it here
       size_t group_id = nd_item.get_group(0);
@@ -222,26 +544,71 @@ B buffer_mapreduce(ExecutionPolicy &snp,
 
       nd_item.barrier(cl::sycl::access::fence_space::local_space);
 
-      if (local_id == 0) {
-        B acc = sum[0];
-        for (size_t local_id = 1;
-             local_id < min(d.nb_work_item, group_end - group_begin);
-             local_id++)
-          acc = reduce(acc, sum[local_id]);
+      local_tree_reduce(nd_item, sum,
+                        min(d.nb_work_item, group_end - group_begin), reduce);
 
-        output[group_id] = acc;
-      }
+      combine_partials_on_last_group(nd_item, sum, is_last, partials, counter,
+                                     d.nb_work_group, init, reduce, result);
     });
-  }).wait();
-  auto read_output = output_buff.template get_access
-    <cl::sycl::access::mode::read>();
+  });
+}
 
-  B acc = init;
-  for (size_t pos0 = 0; pos0 < d.nb_work_group; pos0++) {
-    acc = reduce(acc, read_output[pos0]);
-  }
+template <typename ExecutionPolicy,
+          typename InputIterator,
+          typename B,
+          typename Reduce,
+          typename Map>
+B buffer_mapreduce(ExecutionPolicy &snp,
+                   cl::sycl::queue q,
+                   InputIterator input_iter,
+                   B init, //map is not applied on init
+                   sycl_algorithm_descriptor d,
+                   Map map,
+                   Reduce reduce) {
+  B *result = sycl::helpers::make_temp_device_pointer<
+    B, mapreduce_result_order>(1, q);
+  d = tuned_mapreduce_descriptor(q, typeid(Map).name(), sizeof(B), d,
+    [&](sycl_algorithm_descriptor candidate) {
+      buffer_mapreduce_to_device(snp, q, input_iter, init, candidate, map,
+                                 reduce, result).wait();
+    });
+  buffer_mapreduce_to_device(snp, q, input_iter, init, d, map, reduce, result)
+    .wait();
+  return sycl::helpers::read_device_pointer(result, q);
+}
 
-  return acc;
+/*
+ * Asynchronous buffer_mapreduce, the result is left in ``*result`` or in
+ * memory owned by the returned handle when ``result`` is null. The temporary
+ * memory is allocated for this call only, so several reductions can be in
+ * flight at the same time.
+ */
+template <typename ExecutionPolicy,
+          typename InputIterator,
+          typename B,
+          typename Reduce,
+          typename Map>
+sycl::helpers::device_future<B> buffer_mapreduce_async(ExecutionPolicy &snp,
+                                                       cl::sycl::queue q,
+                                                       InputIterator input_iter,
+                                                       B init,
+                                                       sycl_algorithm_descriptor d,
+                                                       Map map,
+                                                       Reduce reduce,
+                                                       B *result = nullptr) {
+  std::vector<void *> owned;
+  if (result == nullptr) {
+    result = cl::sycl::malloc_device<B>(1, q);
+    owned.push_back(result);
+  }
+  B *partials = cl::sycl::malloc_device<B>(
+    mapreduce_partials_count(q.get_device(), d), q);
+  unsigned int *counter = cl::sycl::malloc_device<unsigned int>(1, q);
+  owned.push_back(partials);
+  owned.push_back(counter);
+  auto event = buffer_mapreduce_to_device(snp, q, input_iter, init, d, map,
+                                          reduce, result, partials, counter);
+  return sycl::helpers::device_future<B>(q, event, result, std::move(owned));
 }
 
 /*
@@ -258,45 +625,62 @@ template <typename ExecutionPolicy,
           typename B,
           typename Reduce,
           typename Map>
-B buffer_map2reduce(ExecutionPolicy &snp,
-                    cl::sycl::queue q,
-                    InputIterator1 input_iter1,
-                    InputIterator2 input_iter2,
-                    B init, //map is not applied on init
-                    sycl_algorithm_descriptor d,
-                    Map map,
-                    Reduce reduce) {
+cl::sycl::event buffer_map2reduce_to_device(ExecutionPolicy &snp,
+                                            cl::sycl::queue q,
+                                            InputIterator1 input_iter1,
+                                            InputIterator2 input_iter2,
+                                            B init, //map is not applied on init
+                                            sycl_algorithm_descriptor d,
+                                            Map map,
+                                            Reduce reduce,
+                                            B *result,
+                                            B *partials = nullptr,
+                                            unsigned int *counter = nullptr) {
   typedef typename std::iterator_traits<InputIterator1>::value_type A1;
   typedef typename std::iterator_traits<InputIterator2>::value_type A2;
 
   if ((d.nb_work_item == 0) || (d.nb_work_group == 0)) {
+    if (partials == nullptr) {
+      partials = sycl::helpers::make_temp_device_pointer<
+        B, mapreduce_partials_order>(mapreduce_partials_count(q.get_device(), d), q);
+    }
     auto read_input1 = input_iter1;
     auto read_input2 = input_iter2;
-    B acc = init;
-    for (size_t pos = 0; pos < d.size; pos++)
-      acc = reduce(acc, map(pos, read_input1[pos], read_input2[pos]));
-
-    return acc;
+    return buffer_global_reduce(
+      q, d.size, init,
+      [=](size_t pos) {
+        return map(pos, read_input1[pos], read_input2[pos]);
+      },
+      reduce, result, partials);
   }
 
   using std::min;
   using std::max;
 
-  // reuse temporary buffer between function calls
-  // cl::sycl::buffer<B, 1> output_buff { cl::sycl::range<1> { d.nb_work_group } };
-  cl::sycl::buffer<B, 1>& output_buff = sycl::helpers::make_temp_buffer<B>(d.nb_work_group);
+  // reuse temporary memory between function calls unless the caller gave some
+  if (partials == nullptr) {
+    partials = sycl::helpers::make_temp_device_pointer<
+      B, mapreduce_partials_order>(d.nb_work_group, q);
+  }
+  if (counter == nullptr) {
+    counter = sycl::helpers::make_temp_device_pointer<
+      unsigned int, mapreduce_counter_order>(1, q);
+  }
+  auto reset = q.fill(counter, 0u, 1);
 
-  q.submit([&] (cl::sycl::handler &cgh) {
+  return q.submit([&] (cl::sycl::handler &cgh) {
+    cgh.depends_on(reset);
     cl::sycl::nd_range<1> rng
       { cl::sycl::range<1>{ d.nb_work_group * d.nb_work_item },
         cl::sycl::range<1>{ d.nb_work_item } };
     auto input1  = input_iter1;
     auto input2  = input_iter2;
-    auto output = output_buff.template get_access
-      <cl::sycl::access::mode::write>(cgh);
     cl::sycl::accessor<B, 1, cl::sycl::access::mode::read_write,
                        cl::sycl::access::target::local>
       sum { cl::sycl::range<1>(d.nb_work_item), cgh };
+    cl::sycl::accessor<int, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+      is_last { cl::sycl::range<1>(1), cgh };
     cgh.parallel_for(
         rng, [=](cl::sycl::nd_item<1> nd_item) {
       size_t group_id = nd_item.get_group(0);
@@ -321,26 +705,155 @@ B buffer_map2reduce(ExecutionPolicy &snp,
 
       nd_item.barrier(cl::sycl::access::fence_space::local_space);
 
-      if (local_id == 0) {
-        B acc = sum[0];
-        for (size_t local_id = 1;
-             local_id < min(d.nb_work_item, group_end - group_begin);
-             local_id++) {
-          acc = reduce(acc, sum[local_id]);
-        }
+      local_tree_reduce(nd_item, sum,
+                        min(d.nb_work_item, group_end - group_begin), reduce);
+
+      combine_partials_on_last_group(nd_item, sum, is_last, partials, counter,
+                                     d.nb_work_group, init, reduce, result);
+    });
+  });
+}
 
-        output[group_id] = acc;
+template <typename ExecutionPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename B,
+          typename Reduce,
+          typename Map>
+B buffer_map2reduce(ExecutionPolicy &snp,
+                    cl::sycl::queue q,
+                    InputIterator1 input_iter1,
+                    InputIterator2 input_iter2,
+                    B init, //map is not applied on init
+                    sycl_algorithm_descriptor d,
+                    Map map,
+                    Reduce reduce) {
+  B *result = sycl::helpers::make_temp_device_pointer<
+    B, mapreduce_result_order>(1, q);
+  d = tuned_mapreduce_descriptor(q, typeid(Map).name(), sizeof(B), d,
+    [&](sycl_algorithm_descriptor candidate) {
+      buffer_map2reduce_to_device(snp, q, input_iter1, input_iter2, init,
+                                  candidate, map, reduce, result).wait();
+    });
+  buffer_map2reduce_to_device(snp, q, input_iter1, input_iter2, init, d, map,
+                              reduce, result)
+    .wait();
+  return sycl::helpers::read_device_pointer(result, q);
+}
+
+/*
+ * Asynchronous buffer_map2reduce, see buffer_mapreduce_async
+ */
+template <typename ExecutionPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename B,
+          typename Reduce,
+          typename Map>
+sycl::helpers::device_future<B> buffer_map2reduce_async(ExecutionPolicy &snp,
+                                                        cl::sycl::queue q,
+                                                        InputIterator1 input_iter1,
+                                                        InputIterator2 input_iter2,
+                                                        B init,
+                                                        sycl_algorithm_descriptor d,
+                                                        Map map,
+                                                        Reduce reduce,
+                                                        B *result = nullptr) {
+  std::vector<void *> owned;
+  if (result == nullptr) {
+    result = cl::sycl::malloc_device<B>(1, q);
+    owned.push_back(result);
+  }
+  B *partials = cl::sycl::malloc_device<B>(
+    mapreduce_partials_count(q.get_device(), d), q);
+  unsigned int *counter = cl::sycl::malloc_device<unsigned int>(1, q);
+  owned.push_back(partials);
+  owned.push_back(counter);
+  auto event = buffer_map2reduce_to_device(snp, q, input_iter1, input_iter2,
+                                           init, d, map, reduce, result,
+                                           partials, counter);
+  return sycl::helpers::device_future<B>(q, event, result, std::move(owned));
+}
+
+/*
+ * Find First on a range of positions
+ *
+ * Returns the first position of [0, size) for which ``test(pos)`` is true,
+ * ``size`` if there is none.
+ * Work groups take chunks of consecutive positions in ascending order from an
+ * atomic counter, and stop as soon as their next chunk starts after the best
+ * position found so far, so a match near the front of the range only costs
+ * the read of a few chunks.
+ */
+template <typename ExecutionPolicy, typename Test>
+size_t buffer_find_first(ExecutionPolicy &snp,
+                         cl::sycl::queue q,
+                         size_t size,
+                         Test test) {
+  using std::min;
+
+  sycl_algorithm_descriptor d =
+    compute_mapreduce_descriptor(q.get_device(), size, sizeof(size_t));
+  if ((d.nb_work_item == 0) || (d.nb_work_group == 0)) {
+    for (size_t pos = 0; pos < size; pos++) {
+      if (test(pos))
+        return pos;
+    }
+    return size;
+  }
+
+  const size_t chunk_size = d.nb_work_item * find_first_items_per_work_item;
+  const size_t nb_chunk = up_rounded_division(size, chunk_size);
+  const size_t nb_work_group = min(d.nb_work_group, nb_chunk);
+
+  // state[0] is the best position so far, state[1] the next chunk to take
+  size_t *state = sycl::helpers::make_temp_device_pointer<
+    size_t, find_first_state_order>(2, q);
+  const size_t init_state[2] = { size, 0 };
+  q.copy(init_state, state, 2).wait();
+
+  q.submit([&] (cl::sycl::handler &cgh) {
+    cl::sycl::range<1> rg { nb_work_group };
+    cl::sycl::range<1> ri { d.nb_work_item };
+    cl::sycl::accessor<size_t, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+      current_chunk { cl::sycl::range<1>(1), cgh };
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri), [=](cl::sycl::nd_item<1> nd_item) {
+      using state_ref =
+          cl::sycl::atomic_ref<size_t, cl::sycl::memory_order::relaxed,
+                               cl::sycl::memory_scope::device,
+                               cl::sycl::access::address_space::global_space>;
+      const size_t local_id = nd_item.get_local_id(0);
+
+      while (true) {
+        if (local_id == 0) {
+          size_t chunk = state_ref(state[1]).fetch_add(size_t{1});
+          // chunks are taken in ascending order, so none of the following
+          // ones can hold a better position either
+          if (chunk >= nb_chunk || chunk * chunk_size >= state_ref(state[0]).load())
+            chunk = nb_chunk;
+          current_chunk[0] = chunk;
+        }
+        nd_item.barrier(cl::sycl::access::fence_space::local_space);
+        const size_t chunk = current_chunk[0];
+        nd_item.barrier(cl::sycl::access::fence_space::local_space);
+        if (chunk == nb_chunk)
+          break;
+
+        const size_t chunk_end = min((chunk + 1) * chunk_size, size);
+        for (size_t pos = chunk * chunk_size + local_id;
+             pos < chunk_end;
+             pos += d.nb_work_item) {
+          if (test(pos)) {
+            state_ref(state[0]).fetch_min(pos);
+            break;
+          }
+        }
       }
     });
   }).wait();
-  auto read_output  = output_buff.template get_access
-    <cl::sycl::access::mode::read>();
-
-  B acc = init;
-  for (size_t pos0 = 0; pos0 < d.nb_work_group; pos0++)
-    acc = reduce(acc, read_output[pos0]);
 
-  return acc;
+  return sycl::helpers::read_device_pointer(state, q);
 }
 
 
@@ -352,8 +865,8 @@ sycl_algorithm_descriptor compute_mapscan_descriptor(cl::sycl::device device,
   using std::max;
   if (size == 0)
     return sycl_algorithm_descriptor {};
-  size_t local_mem_size =
-    device.get_info<cl::sycl::info::device::local_mem_size>();
+  const auto &properties = sycl::helpers::get_device_properties(device);
+  size_t local_mem_size = properties.local_mem_size;
   // "/ 2" is used here as a "soft" limit,
   // because some additional memory may be required in kernels
   // ref: rocprim::detail::limit_block_size
@@ -363,17 +876,7 @@ sycl_algorithm_descriptor compute_mapscan_descriptor(cl::sycl::device device,
 
   size_t nb_work_group = up_rounded_division(size, size_per_work_group);
 
-  const cl::sycl::id<3> max_work_item_sizes =
-    device.get_info<
-#if defined(__COMPUTECPP__)
-      cl::sycl::info::device::max_work_item_sizes
-#else
-      cl::sycl::info::device::max_work_item_sizes<3>
-#endif
-    >();
-  const auto max_work_item = min(
-    device.get_info<cl::sycl::info::device::max_work_group_size>(),
-    max_work_item_sizes[0]);
+  const auto max_work_item = properties.max_work_item;
   size_t nb_work_item = min(max_work_item, size_per_work_group);
   size_t size_per_work_item =
     up_rounded_division(size_per_work_group, nb_work_item);
@@ -386,6 +889,107 @@ sycl_algorithm_descriptor compute_mapscan_descriptor(cl::sycl::device device,
 }
 
 
+/*
+ * Inclusive scan for types too large for local memory, see
+ * buffer_global_reduce: every work item scans a contiguous chunk of at least
+ * two elements in place in ``output``, the totals of the chunks are scanned
+ * recursively the same way in global memory, then every chunk adds the
+ * total of the chunks before it.
+ * ``load(pos)`` returns the mapped value at ``pos``, it may read the
+ * position ``pos`` of ``output``.
+ */
+inline size_t global_scan_chunk(cl::sycl::device device, size_t size) {
+  const size_t nb_chunks_max =
+    global_reduce_partial_count(device, std::max<size_t>(size / 2, 1));
+  return up_rounded_division(size, nb_chunks_max);
+}
+
+/*
+ * Number of totals of all the levels of buffer_global_scan
+ */
+inline size_t global_scan_totals_count(cl::sycl::device device, size_t size) {
+  size_t count = 0;
+  while (size > 0) {
+    const size_t nb_chunks =
+      up_rounded_division(size, global_scan_chunk(device, size));
+    count += nb_chunks;
+    size = nb_chunks - 1;
+  }
+  return count;
+}
+
+/*
+ * Load of the levels of buffer_global_scan after the first one, a named type
+ * so that the recursion over the levels instantiates a single function
+ */
+template <typename B>
+struct global_scan_totals_load {
+  const B *totals;
+  B operator()(size_t pos) const { return totals[pos]; }
+};
+
+/*
+ * Level of buffer_global_scan, with the totals of its chunks at the start of
+ * ``totals`` and those of the next levels after them. The kernels run after
+ * ``dependencies``, the event of the last one is returned.
+ */
+template <typename B, typename Load, typename OutputIterator, typename Reduce>
+cl::sycl::event buffer_global_scan_level(
+    cl::sycl::queue q, size_t size, B init, Load load, OutputIterator output,
+    Reduce red, B *totals, const std::vector<cl::sycl::event> &dependencies) {
+  using std::min;
+  const size_t chunk = global_scan_chunk(q.get_device(), size);
+  const size_t nb_chunks = up_rounded_division(size, chunk);
+
+  auto scanned = submit_global_range(q, nb_chunks, [=](size_t id) {
+    const size_t begin = id * chunk;
+    const size_t end = min(begin + chunk, size);
+    B acc = load(begin);
+    output[begin] = acc;
+    for (size_t pos = begin + 1; pos < end; pos++) {
+      acc = red(acc, load(pos));
+      output[pos] = acc;
+    }
+    totals[id] = acc;
+  }, dependencies);
+
+  // totals[c] becomes the scan of the chunks up to c, init included
+  if (nb_chunks > 1) {
+    scanned = buffer_global_scan_level(
+      q, nb_chunks - 1, init, global_scan_totals_load<B>{totals}, totals,
+      red, totals + nb_chunks, {scanned});
+  }
+
+  return submit_global_range(q, nb_chunks, [=](size_t id) {
+    const size_t begin = id * chunk;
+    const size_t end = min(begin + chunk, size);
+    const B acc = (id == 0) ? init : totals[id - 1];
+    for (size_t pos = begin; pos < end; pos++) {
+      output[pos] = red(acc, output[pos]);
+    }
+  }, {scanned});
+}
+
+/*
+ * The totals of every level share one temporary allocation, and the levels
+ * are chained by their events, so only the end of the scan is waited for.
+ */
+template <typename B, typename Load, typename OutputIterator, typename Reduce>
+void buffer_global_scan(cl::sycl::queue q,
+                        size_t size,
+                        B init,
+                        Load load,
+                        OutputIterator output,
+                        Reduce red) {
+  if (size == 0)
+    return;
+  B *totals = sycl::helpers::make_temp_device_pointer<
+    B, global_scan_totals_order>(
+      global_scan_totals_count(q.get_device(), size), q);
+  buffer_global_scan_level(q, size, init, load, output, red, totals, {})
+    .wait();
+}
+
 template <class ExecutionPolicy, class InputIterator, class OutputIterator, class B, class Reduce, class Map>
 void buffer_mapscan(ExecutionPolicy &snp,
                     cl::sycl::queue q,
@@ -403,6 +1007,18 @@ void buffer_mapscan(ExecutionPolicy &snp,
   using std::min;
   using std::max;
 
+  if (d.size == 0)
+    return;
+
+  if ((d.nb_work_item == 0) || (d.nb_work_group == 0)) {
+    // the elements do not fit in local memory
+    auto input = input_iter;
+    buffer_global_scan(q, d.size, init,
+                       [=](size_t pos) { return map(input[pos]); },
+                       output_iter, red);
+    return;
+  }
+
   //WARNING: nb_work_group is not bounded by max_compute_units
   // reuse temporary buffer between function calls
   //cl::sycl::buffer<B, 1> scan = { cl::sycl::range<1> { d.nb_work_group } };
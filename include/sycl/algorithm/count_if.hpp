@@ -103,31 +103,141 @@ typename std::iterator_traits<InputIterator>::difference_type count_if(
   return hr[0];
 }
 
+/* count_if.
+ * Counts with the additions of integers, see the overload without binary
+ * operation of the new implementation.
+ */
+template <class ExecutionPolicy, class InputIterator, class UnaryOperation>
+typename std::iterator_traits<InputIterator>::difference_type count_if(
+    ExecutionPolicy& exec, InputIterator first, InputIterator last,
+    UnaryOperation unary_op) {
+  return count_if(exec, first, last, unary_op,
+                  [](int x, int y) { return x + y; });
+}
+
 #else
 
+/*
+ * Number of consecutive elements tested by a work item at each step of
+ * count_if, so that contiguous inputs are read with wide loads
+ */
+constexpr size_t count_if_items_per_work_item = 4;
+
+/*
+ * make_temp_device_pointer slot holding the count
+ */
+constexpr int count_if_result_order = 21;
+
+/* count_if.
+ * Counts the elements for which unary_op is true by adding the counts of
+ * the elements with binary_op, in a map reduce without atomics on the count.
+ */
 template <typename ExecutionPolicy, typename InputIt, typename UnaryOperation,
           typename BinaryOperation>
 typename std::iterator_traits<InputIt>::difference_type count_if(
     ExecutionPolicy& snp, InputIt b, InputIt e,
     UnaryOperation unary_op, BinaryOperation binary_op) {
-
+  using difference_type =
+      typename std::iterator_traits<InputIt>::difference_type;
+  using value_type = typename std::iterator_traits<InputIt>::value_type;
 
   auto q = snp.get_queue();
   auto size = sycl::helpers::distance(b, e);
   if(size <= 0) return 0;
 
   auto device = q.get_device();
-  using value_type = typename std::iterator_traits<InputIt>::value_type;
-
-
-  auto d = compute_mapreduce_descriptor(device, size, sizeof(size_t));
-
+  auto d = compute_mapreduce_descriptor(device, size, sizeof(difference_type));
   auto map = [=](size_t pos, value_type x) {
-    return (unary_op(x)) ? 1 : 0;
+    return difference_type{unary_op(x) ? 1 : 0};
   };
+  return buffer_mapreduce(snp, q, b, difference_type{0}, d, map, binary_op);
+}
+
+/* count_if.
+ * Every work item counts the matches of blocks of consecutive elements in a
+ * 64-bit counter, the counts are added over each sub-group, then each work
+ * group adds its total to the global count with a single atomic. Devices
+ * without 64-bit atomics count with the map reduce of the overload above.
+ */
+template <typename ExecutionPolicy, typename InputIt, typename UnaryPredicate>
+typename std::iterator_traits<InputIt>::difference_type count_if(
+    ExecutionPolicy& snp, InputIt b, InputIt e, UnaryPredicate p) {
+  using difference_type =
+      typename std::iterator_traits<InputIt>::difference_type;
+  using count_type = unsigned long long;
 
-  return buffer_mapreduce( snp, q, b, 0, d, map, binary_op );
+  auto q = snp.get_queue();
+  auto size = sycl::helpers::distance(b, e);
+  if(size <= 0) return 0;
 
+  auto device = q.get_device();
+  if (!device.has(cl::sycl::aspect::atomic64)) {
+    return count_if(snp, b, e, p, [](difference_type x, difference_type y) {
+      return x + y;
+    });
+  }
+  const size_t n = size;
+  const size_t nb_block = up_rounded_division(n, count_if_items_per_work_item);
+  const auto d = compute_mapreduce_descriptor(device, nb_block,
+                                              sizeof(count_type));
+
+  count_type* result = sycl::helpers::make_temp_device_pointer<
+      count_type, count_if_result_order>(1, q);
+  auto reset = q.fill(result, count_type{0}, 1);
+
+  q.submit([&](cl::sycl::handler& cgh) {
+    cgh.depends_on(reset);
+    cl::sycl::range<1> rg{d.nb_work_group};
+    cl::sycl::range<1> ri{d.nb_work_item};
+    auto input = b;
+    cl::sycl::accessor<count_type, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+        group_count{cl::sycl::range<1>(1), cgh};
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                     [=](cl::sycl::nd_item<1> nd_item) {
+      using global_ref =
+          cl::sycl::atomic_ref<count_type, cl::sycl::memory_order::relaxed,
+                               cl::sycl::memory_scope::device,
+                               cl::sycl::access::address_space::global_space>;
+      using local_ref =
+          cl::sycl::atomic_ref<count_type, cl::sycl::memory_order::relaxed,
+                               cl::sycl::memory_scope::work_group,
+                               cl::sycl::access::address_space::local_space>;
+      const size_t local_id = nd_item.get_local_id(0);
+      const size_t global_id = nd_item.get_global_id(0);
+      const size_t global_size = d.nb_work_group * d.nb_work_item;
+
+      if (local_id == 0)
+        group_count[0] = 0;
+      nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+      count_type count = 0;
+      for (size_t block = global_id; block < nb_block; block += global_size) {
+        const size_t begin = block * count_if_items_per_work_item;
+        if (begin + count_if_items_per_work_item <= n) {
+          // full block, of constant length so the reads can be merged
+          for (size_t i = 0; i < count_if_items_per_work_item; i++)
+            count += p(input[begin + i]) ? 1 : 0;
+        } else {
+          for (size_t pos = begin; pos < n; pos++)
+            count += p(input[pos]) ? 1 : 0;
+        }
+      }
+
+      auto sub_group = nd_item.get_sub_group();
+      count = cl::sycl::reduce_over_group(sub_group, count,
+                                          cl::sycl::plus<count_type>());
+      if (sub_group.leader())
+        local_ref(group_count[0]).fetch_add(count);
+      nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+      if (local_id == 0 && group_count[0] != 0)
+        global_ref(*result).fetch_add(group_count[0]);
+    });
+  }).wait();
+
+  return static_cast<difference_type>(
+      sycl::helpers::read_device_pointer(result, q));
 }
 #endif
 
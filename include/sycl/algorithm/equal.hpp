@@ -37,6 +37,7 @@
 // SYCL helpers header
 #include <sycl/algorithm/algorithm_composite_patterns.hpp>
 #include <sycl/algorithm/buffer_algorithms.hpp>
+#include <sycl/algorithm/mismatch.hpp>
 #include <sycl/helpers/sycl_buffers.hpp>
 #include <sycl/helpers/sycl_differences.hpp>
 
@@ -132,16 +133,8 @@ bool equal(ExecutionPolicy&& exec, ForwardIt1 first1, ForwardIt1 last1,
     return true;
   }
 
-  auto device = q.get_device();
-  using value_type1 = typename std::iterator_traits<ForwardIt1>::value_type;
-  using value_type2 = typename std::iterator_traits<ForwardIt2>::value_type;
-
-  auto d = compute_mapreduce_descriptor(device, size1, sizeof(std::size_t));
-
-  return buffer_map2reduce(
-      exec, q, first1, first2, true, d,
-      [p](std::size_t pos, value_type1 x, value_type2 y) { return p(x, y); },
-      std::logical_and<bool>{});
+  return detail::first_difference(exec, q, first1, first2, size1, p) ==
+         static_cast<std::size_t>(size1);
 }
 
 #endif
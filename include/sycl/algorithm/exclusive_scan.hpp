@@ -29,10 +29,15 @@
 #ifndef __SYCL_IMPL_ALGORITHM_EXCLUSIVE_SCAN__
 #define __SYCL_IMPL_ALGORITHM_EXCLUSIVE_SCAN__
 
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
 #include <sycl/helpers/sycl_buffers.hpp>
 #include <sycl/helpers/sycl_differences.hpp>
 #include <sycl/helpers/sycl_namegen.hpp>
 #include <sycl/algorithm/buffer_algorithms.hpp>
+#include <sycl/algorithm/copy.hpp>
 
 namespace sycl {
 namespace impl {
@@ -124,7 +129,37 @@ OutputIterator exclusive_scan(ExecutionPolicy &sep, InputIterator b,
 
 #else
 
+namespace detail {
+
+/*
+ * make_temp_device_pointer slot holding the copy of an aliased input
+ */
+constexpr int exclusive_scan_input_order = 20;
+
+/* True when writing the scan of [first, last) to d_first + 1.. would
+ * overwrite input elements not read yet, as the chunks are scanned in
+ * parallel: the output starts inside the input, in-place scans included.
+ */
+template <class InputIt, class OutputIt>
+bool exclusive_scan_needs_temp(InputIt first, InputIt last, OutputIt d_first) {
+  if constexpr (std::contiguous_iterator<InputIt> &&
+                std::contiguous_iterator<OutputIt>) {
+    const auto in_begin = std::to_address(first);
+    const auto in_end = std::to_address(last);
+    const auto out_begin = std::to_address(d_first);
+    if constexpr (std::is_same_v<decltype(in_begin), decltype(out_begin)>) {
+      return (in_begin <= out_begin) && (out_begin + 1 < in_end);
+    }
+  }
+  return false;
+}
+
+}  // namespace detail
 
+/* exclusive_scan.
+ * Inclusive scan of [b, e - 1) written to o + 1, and init written to o.
+ * An input aliased by the output is copied to a temporary first.
+ */
 template <typename ExecutionPolicy,
           typename InputIterator,
           typename OutputIterator,
@@ -144,9 +179,18 @@ OutputIterator exclusive_scan(ExecutionPolicy &snp, InputIterator b,
 
   if (size > 1) {
     auto d = compute_mapscan_descriptor(device, size - 1, sizeof(value_type));
-    buffer_mapscan(snp, q, b, o + 1, init, d,
-                   [](value_type x) { return x; },
-                   bop);
+    if (detail::exclusive_scan_needs_temp(b, e, o)) {
+      value_type* tmp = sycl::helpers::make_temp_device_pointer<
+          value_type, detail::exclusive_scan_input_order>(size - 1, q);
+      ::sycl::impl::copy(snp, b, std::prev(e), tmp);
+      buffer_mapscan(snp, q, tmp, o + 1, init, d,
+                     [](value_type x) { return x; },
+                     bop);
+    } else {
+      buffer_mapscan(snp, q, b, o + 1, init, d,
+                     [](value_type x) { return x; },
+                     bop);
+    }
   }
 
   auto f = [o, init] (cl::sycl::handler &h) mutable {
@@ -156,7 +200,7 @@ OutputIterator exclusive_scan(ExecutionPolicy &snp, InputIterator b,
         }
     );
   };
-  q.submit(f).wait();
+  snp.complete(q.submit(f));
 
   return std::next(o, size);
 }
@@ -60,7 +60,7 @@ void fill(ExecutionPolicy &sep, ForwardIt b, ForwardIt e, const T &value) {
           }
         });
   };
-  q.submit(f).wait();
+  sep.complete(q.submit(f));
 }
 
 }  // namespace impl
@@ -143,16 +143,12 @@ InputIt find_impl(ExecutionPolicy &snp, InputIt b, InputIt e,
   }
 
   const auto q = snp.get_queue();
-  const auto device = q.get_device();
   using value_type = typename std::iterator_traits<InputIt>::value_type;
 
-  const auto d =
-      compute_mapreduce_descriptor(device, size, sizeof(std::size_t));
-
-  const auto pos = buffer_mapreduce(
-      snp, q, b, size, d,
-      [p, size](std::size_t pos, value_type x) { return p(x) ? pos : size; },
-      [](std::size_t x, std::size_t y) { return cl::sycl::min(x, y); });
+  const auto pos = buffer_find_first(snp, q, size, [b, p](std::size_t pos) {
+    value_type x = b[pos];
+    return p(x);
+  });
 
   if (pos == size) {
     return e;
@@ -59,7 +59,7 @@ void for_each(ExecutionPolicy &sep, Iterator b, Iterator e, UnaryFunction op) {
             }
           });
     };
-    q.submit(f).wait();
+    sep.complete(q.submit(f));
   }
 }
 
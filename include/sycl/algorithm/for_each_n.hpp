@@ -68,7 +68,7 @@ InputIterator for_each_n(ExecutionPolicy &exec, InputIterator first, Size n,
             }
           });
     };
-    q.submit(cg).wait();
+    exec.complete(q.submit(cg));
     return last;
   } else {
     return first;
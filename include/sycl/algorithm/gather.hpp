@@ -30,7 +30,7 @@ void gather(ExecutionPolicy &sep, MapIterator first, MapIterator last,
           }
         });
   };
-  q.submit(f).wait();
+  sep.complete(q.submit(f));
 }
 
 }  // namespace impl
@@ -62,7 +62,7 @@ void generate(ExecutionPolicy &sep, ForwardIt first, ForwardIt last,
           }
         });
   };
-  q.submit(f).wait();
+  sep.complete(q.submit(f));
 }
 
 }  // namespace impl
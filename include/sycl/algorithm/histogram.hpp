@@ -0,0 +1,310 @@
+#ifndef __SYCL_IMPL_ALGORITHM_HISTOGRAM__
+#define __SYCL_IMPL_ALGORITHM_HISTOGRAM__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <sycl/helpers/sycl_differences.hpp>
+#include <sycl/algorithm/buffer_algorithms.hpp>
+
+namespace sycl {
+namespace impl {
+
+namespace detail {
+
+/* Bin of a sample among ``nbins`` bins of the same width splitting
+ * [lower, upper), ``nbins`` when the sample is out of range.
+ */
+template <typename Level>
+struct even_binning {
+  size_t nbins;
+  Level lower;
+  Level upper;
+
+  template <typename T>
+  size_t operator()(const T &sample) const {
+    const Level x = static_cast<Level>(sample);
+    if (!(lower <= x && x < upper))
+      return nbins;
+    size_t bin;
+    if constexpr (std::is_integral_v<Level>) {
+      // widened so that (x - lower) * nbins does not overflow for small types
+      using wide = std::conditional_t<std::is_signed_v<Level>, long long,
+                                      unsigned long long>;
+      bin = static_cast<size_t>((static_cast<wide>(x) - lower) *
+                                static_cast<wide>(nbins) /
+                                (static_cast<wide>(upper) - lower));
+    } else {
+      bin = static_cast<size_t>((x - lower) / (upper - lower) * nbins);
+    }
+    // rounding may push samples just below upper into the last bin + 1
+    return std::min(bin, nbins - 1);
+  }
+};
+
+/* Bin of a sample among the ``nbins`` bins [levels[i], levels[i + 1]), found
+ * by binary search, ``nbins`` when the sample is out of range.
+ */
+template <typename LevelIt>
+struct range_binning {
+  size_t nbins;
+  LevelIt levels;
+
+  template <typename T>
+  size_t operator()(const T &sample) const {
+    using level_type = typename std::iterator_traits<LevelIt>::value_type;
+    const level_type x = static_cast<level_type>(sample);
+    if (!(levels[0] <= x && x < levels[nbins]))
+      return nbins;
+    // levels[low] <= x < levels[high]
+    size_t low = 0, high = nbins;
+    while (high - low > 1) {
+      const size_t mid = low + (high - low) / 2;
+      if (x < levels[mid])
+        high = mid;
+      else
+        low = mid;
+    }
+    return low;
+  }
+};
+
+/* Calls ``add(channel, bin)`` for every channel of ``sample``, a std::tuple
+ * holding one value per channel.
+ */
+template <typename Sample, typename Binning, size_t N, typename Add,
+          size_t... Channel>
+void bin_channels(const Sample &sample, const std::array<Binning, N> &binnings,
+                  Add add, std::index_sequence<Channel...>) {
+  (add(Channel, binnings[Channel](std::get<Channel>(sample))), ...);
+}
+
+/*
+ * Histogram of the ``size`` samples given by ``sample(pos)``, each of them a
+ * std::tuple of N channels binned by ``binnings`` into ``bins``, which are
+ * overwritten.
+ * Each work group counts its samples in private bins in local memory with
+ * atomics, then adds its non-zero bins to the global ones, so the global
+ * atomics do not depend on the number of samples. When the bins of all the
+ * channels do not fit in local memory, samples are counted in the global bins
+ * directly.
+ */
+template <typename ExecutionPolicy, typename Sample, typename OutputIt,
+          typename Binning, size_t N>
+void buffer_histogram(ExecutionPolicy &snp, cl::sycl::queue q, size_t size,
+                      Sample sample, const std::array<OutputIt, N> &bins,
+                      const std::array<Binning, N> &binnings) {
+  using counter_type = typename std::iterator_traits<OutputIt>::value_type;
+  using global_ref =
+      cl::sycl::atomic_ref<counter_type, cl::sycl::memory_order::relaxed,
+                           cl::sycl::memory_scope::device,
+                           cl::sycl::access::address_space::global_space>;
+  using local_ref =
+      cl::sycl::atomic_ref<counter_type, cl::sycl::memory_order::relaxed,
+                           cl::sycl::memory_scope::work_group,
+                           cl::sycl::access::address_space::local_space>;
+
+  // bins of the channels are laid out one after the other
+  std::array<size_t, N + 1> offsets;
+  offsets[0] = 0;
+  for (size_t c = 0; c < N; c++) {
+    offsets[c + 1] = offsets[c] + binnings[c].nbins;
+  }
+  const size_t nb_bins = offsets[N];
+  if (nb_bins == 0)
+    return;
+
+  auto device = q.get_device();
+  const size_t max_work_item = max_work_item_count(device);
+
+  // global bin of index ``bin`` among the bins of all the channels
+  auto output_bin = [bins, offsets](size_t bin) -> counter_type & {
+    size_t c = 0;
+    while (bin >= offsets[c + 1])
+      c++;
+    return bins[c][bin - offsets[c]];
+  };
+
+  q.submit([&](cl::sycl::handler &cgh) {
+    const size_t nb_work_item = std::min(max_work_item, nb_bins);
+    cl::sycl::range<1> rg{up_rounded_division(nb_bins, nb_work_item)};
+    cl::sycl::range<1> ri{nb_work_item};
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                     [=](cl::sycl::nd_item<1> nd_item) {
+      const size_t bin = nd_item.get_global_id(0);
+      if (bin < nb_bins)
+        output_bin(bin) = counter_type{};
+    });
+  }).wait();
+
+  if (size == 0)
+    return;
+
+  const size_t local_mem_size =
+      sycl::helpers::get_device_properties(device).local_mem_size;
+  const bool privatized = nb_bins * sizeof(counter_type) <= local_mem_size / 2;
+  const auto d = compute_mapreduce_descriptor(device, size, sizeof(counter_type));
+  const size_t nb_work_item = std::max<size_t>(d.nb_work_item, 1);
+  const size_t nb_work_group = std::max<size_t>(d.nb_work_group, 1);
+  const size_t nb_local_bins = privatized ? nb_bins : 1;
+
+  q.submit([&](cl::sycl::handler &cgh) {
+    cl::sycl::range<1> rg{nb_work_group};
+    cl::sycl::range<1> ri{nb_work_item};
+    cl::sycl::accessor<counter_type, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+        local_bins{cl::sycl::range<1>(nb_local_bins), cgh};
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                     [=](cl::sycl::nd_item<1> nd_item) {
+      const size_t local_id = nd_item.get_local_id(0);
+      const size_t global_id = nd_item.get_global_id(0);
+      const size_t global_size = nb_work_group * nb_work_item;
+
+      if (privatized) {
+        for (size_t bin = local_id; bin < nb_bins; bin += nb_work_item) {
+          local_bins[bin] = counter_type{};
+        }
+        nd_item.barrier(cl::sycl::access::fence_space::local_space);
+      }
+
+      auto add = [&](size_t c, size_t bin) {
+        if (bin >= binnings[c].nbins)
+          return;
+        if (privatized) {
+          local_ref(local_bins[offsets[c] + bin]).fetch_add(counter_type{1});
+        } else {
+          global_ref(bins[c][bin]).fetch_add(counter_type{1});
+        }
+      };
+      for (size_t pos = global_id; pos < size; pos += global_size) {
+        bin_channels(sample(pos), binnings, add, std::make_index_sequence<N>{});
+      }
+
+      if (privatized) {
+        nd_item.barrier(cl::sycl::access::fence_space::local_space);
+        for (size_t bin = local_id; bin < nb_bins; bin += nb_work_item) {
+          const counter_type count = local_bins[bin];
+          if (count != counter_type{})
+            global_ref(output_bin(bin)).fetch_add(count);
+        }
+      }
+    });
+  }).wait();
+}
+
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt,
+          typename Binning>
+OutputIt histogram(ExecutionPolicy &snp, InputIt first, InputIt last,
+                   OutputIt bins, const Binning &binning) {
+  using value_type = typename std::iterator_traits<InputIt>::value_type;
+  auto q = snp.get_queue();
+  const auto size = sycl::helpers::distance(first, last);
+  buffer_histogram(snp, q, std::max<decltype(size)>(size, 0),
+                   [first](size_t pos) {
+                     value_type x = first[pos];
+                     return std::make_tuple(x);
+                   },
+                   std::array<OutputIt, 1>{bins},
+                   std::array<Binning, 1>{binning});
+  return std::next(bins, binning.nbins);
+}
+
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt,
+          typename Binning, size_t N>
+void multi_histogram(ExecutionPolicy &snp, InputIt first, InputIt last,
+                     const std::array<OutputIt, N> &bins,
+                     const std::array<Binning, N> &binnings) {
+  using value_type = typename std::iterator_traits<InputIt>::value_type;
+  static_assert(std::tuple_size_v<value_type> == N,
+                "one set of bins is needed per channel");
+  auto q = snp.get_queue();
+  const auto size = sycl::helpers::distance(first, last);
+  buffer_histogram(snp, q, std::max<decltype(size)>(size, 0),
+                   [first](size_t pos) {
+                     value_type x = first[pos];
+                     return x;
+                   },
+                   bins, binnings);
+}
+
+}  // namespace detail
+
+/* histogram_even.
+ * Counts the samples of [first, last) in ``nbins`` bins of the same width
+ * splitting [lower, upper) and writes the counts to [bins, bins + nbins).
+ * Samples out of [lower, upper) are not counted. The counters, of the value
+ * type of ``bins``, are updated with atomics, so it must be an integral type
+ * the device supports atomics on.
+ * Returns ``bins + nbins``.
+ */
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt,
+          typename Level>
+OutputIt histogram_even(ExecutionPolicy &snp, InputIt first, InputIt last,
+                        OutputIt bins, size_t nbins, Level lower, Level upper) {
+  return detail::histogram(snp, first, last, bins,
+                           detail::even_binning<Level>{nbins, lower, upper});
+}
+
+/* histogram_range.
+ * Counts the samples of [first, last) in the ``nbins`` bins
+ * [levels[i], levels[i + 1]), ``levels`` holding ``nbins + 1`` increasing
+ * edges readable from the device, and writes the counts to
+ * [bins, bins + nbins). Samples out of [levels[0], levels[nbins]) are not
+ * counted.
+ * Returns ``bins + nbins``.
+ */
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt,
+          typename LevelIt>
+OutputIt histogram_range(ExecutionPolicy &snp, InputIt first, InputIt last,
+                         OutputIt bins, size_t nbins, LevelIt levels) {
+  return detail::histogram(snp, first, last, bins,
+                           detail::range_binning<LevelIt>{nbins, levels});
+}
+
+/* multi_histogram_even.
+ * histogram_even of every channel of the samples of [first, last), typically
+ * a ZipIter over one range per channel, in a single pass. Channel ``c`` is
+ * counted in ``nbins[c]`` bins splitting [lower[c], upper[c]) written to
+ * ``bins[c]``.
+ */
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt,
+          typename Level, size_t N>
+void multi_histogram_even(ExecutionPolicy &snp, InputIt first, InputIt last,
+                          const std::array<OutputIt, N> &bins,
+                          const std::array<size_t, N> &nbins,
+                          const std::array<Level, N> &lower,
+                          const std::array<Level, N> &upper) {
+  std::array<detail::even_binning<Level>, N> binnings;
+  for (size_t c = 0; c < N; c++) {
+    binnings[c] = detail::even_binning<Level>{nbins[c], lower[c], upper[c]};
+  }
+  detail::multi_histogram(snp, first, last, bins, binnings);
+}
+
+/* multi_histogram_range.
+ * histogram_range of every channel of the samples of [first, last) in a
+ * single pass. Channel ``c`` is counted in the ``nbins[c]`` bins given by the
+ * ``nbins[c] + 1`` edges at ``levels[c]`` and written to ``bins[c]``.
+ */
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt,
+          typename LevelIt, size_t N>
+void multi_histogram_range(ExecutionPolicy &snp, InputIt first, InputIt last,
+                           const std::array<OutputIt, N> &bins,
+                           const std::array<size_t, N> &nbins,
+                           const std::array<LevelIt, N> &levels) {
+  std::array<detail::range_binning<LevelIt>, N> binnings;
+  for (size_t c = 0; c < N; c++) {
+    binnings[c] = detail::range_binning<LevelIt>{nbins[c], levels[c]};
+  }
+  detail::multi_histogram(snp, first, last, bins, binnings);
+}
+
+}  // namespace impl
+}  // namespace sycl
+
+#endif  // __SYCL_IMPL_ALGORITHM_HISTOGRAM__
@@ -31,9 +31,13 @@
 
 #include <type_traits>
 #include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 
 #include <sycl/algorithm/algorithm_composite_patterns.hpp>
 #include <sycl/algorithm/buffer_algorithms.hpp>
+#include <sycl/helpers/sycl_device_future.hpp>
 #include <sycl/helpers/sycl_differences.hpp>
 #include <sycl/helpers/sycl_iterator.hpp>
 
@@ -165,8 +169,27 @@ T inner_product(ExecutionPolicy &exec, InputIt1 first1, InputIt1 last1,
 
 #else
 
+namespace detail {
+
+/* Elements read together by a single load in inner_product. */
+constexpr size_t inner_product_pack_size = 4;
+
+template <typename T, size_t N>
+struct alignas(N * sizeof(T)) packed_values {
+  T v[N];
+};
+
+}  // namespace detail
+
 /*
  * Inner Product Algorithm
+ *
+ * Contiguous ranges of arithmetic types are read by packs of
+ * inner_product_pack_size elements, each work item combining the elements of
+ * a pack before the usual reduction. The elements before the first aligned
+ * pack are taken by the first pack and the remaining ones by the last pack,
+ * so the packs are used whenever both ranges reach the pack alignment after
+ * the same count of elements.
  */
 
 template <class ExecutionPolicy, class InputIt1, class InputIt2, class T,
@@ -180,11 +203,59 @@ T inner_product(ExecutionPolicy &snp, InputIt1 first1, InputIt1 last1,
   auto size = sycl::helpers::distance(first1, last1);
   if (size <= 0)
     return value;
-  InputIt2 last2 = std::next(first2, size);
 
   using value_type_1 = typename std::iterator_traits<InputIt1>::value_type;
   using value_type_2 = typename std::iterator_traits<InputIt2>::value_type;
 
+  if constexpr (std::contiguous_iterator<InputIt1> &&
+                std::contiguous_iterator<InputIt2> &&
+                std::is_arithmetic_v<value_type_1> &&
+                std::is_arithmetic_v<value_type_2>) {
+    constexpr size_t N = detail::inner_product_pack_size;
+    using pack_1 = detail::packed_values<value_type_1, N>;
+    using pack_2 = detail::packed_values<value_type_2, N>;
+    const value_type_1 *ptr1 = std::to_address(first1);
+    const value_type_2 *ptr2 = std::to_address(first2);
+    // elements of the first range before its first aligned pack
+    const size_t misalignment =
+        reinterpret_cast<std::uintptr_t>(ptr1) % alignof(pack_1);
+    const size_t head =
+        (misalignment == 0) ? 0
+                            : (alignof(pack_1) - misalignment) /
+                                  sizeof(value_type_1);
+    const size_t total = size;
+    const size_t nb_packs = (total > head) ? (total - head) / N : 0;
+    if (nb_packs > 0 && misalignment % sizeof(value_type_1) == 0 &&
+        reinterpret_cast<std::uintptr_t>(ptr2 + head) % alignof(pack_2) ==
+            0) {
+      auto d = compute_mapreduce_descriptor(device, nb_packs,
+                                            sizeof(pack_1) + sizeof(pack_2));
+      auto map = [=](size_t pos, pack_1 x, pack_2 y) {
+        const bool with_head = (pos == 0 && head > 0);
+        T acc = with_head ? op2(ptr1[0], ptr2[0]) : op2(x.v[0], y.v[0]);
+        if (with_head) {
+          for (size_t i = 1; i < head; i++) {
+            acc = op1(acc, op2(ptr1[i], ptr2[i]));
+          }
+          acc = op1(acc, op2(x.v[0], y.v[0]));
+        }
+        for (size_t i = 1; i < N; i++) {
+          acc = op1(acc, op2(x.v[i], y.v[i]));
+        }
+        if (pos == nb_packs - 1) {
+          for (size_t i = head + nb_packs * N; i < total; i++) {
+            acc = op1(acc, op2(ptr1[i], ptr2[i]));
+          }
+        }
+        return acc;
+      };
+      return buffer_map2reduce(snp, q,
+                               reinterpret_cast<const pack_1 *>(ptr1 + head),
+                               reinterpret_cast<const pack_2 *>(ptr2 + head),
+                               value, d, map, op1);
+    }
+  }
+
 
   auto d = compute_mapreduce_descriptor(
       device, size, sizeof(value_type_1)+sizeof(value_type_2));
@@ -197,6 +268,49 @@ T inner_product(ExecutionPolicy &snp, InputIt1 first1, InputIt1 last1,
                            value, d, map, op1 );
 }
 
+/*
+ * Asynchronous inner_product, the result stays on the device until get() is
+ * called on the returned handle. If ``result`` is given, the value is
+ * written there.
+ */
+template <class ExecutionPolicy, class InputIt1, class InputIt2, class T,
+          class BinaryOperation1, class BinaryOperation2>
+sycl::helpers::device_future<T> inner_product_async(
+    ExecutionPolicy &snp, InputIt1 first1, InputIt1 last1, InputIt2 first2,
+    T value, BinaryOperation1 op1, BinaryOperation2 op2,
+    T *result = nullptr) {
+
+  auto q = snp.get_queue();
+  auto device = q.get_device();
+  auto size = sycl::helpers::distance(first1, last1);
+
+  using value_type_1 = typename std::iterator_traits<InputIt1>::value_type;
+  using value_type_2 = typename std::iterator_traits<InputIt2>::value_type;
+
+  auto d = compute_mapreduce_descriptor(
+      device, size, sizeof(value_type_1)+sizeof(value_type_2));
+
+  auto map = [=](size_t pos, value_type_1 x, value_type_2 y) {
+    return op2(x, y);
+  };
+
+  return buffer_map2reduce_async(snp, q, first1, first2,
+                                 value, d, map, op1, result);
+}
+
+/*
+ * inner_product_async writing into a device_pointer
+ */
+template <class ExecutionPolicy, class InputIt1, class InputIt2, class T,
+          class BinaryOperation1, class BinaryOperation2>
+sycl::helpers::device_future<T> inner_product_async(
+    ExecutionPolicy &snp, InputIt1 first1, InputIt1 last1, InputIt2 first2,
+    T value, BinaryOperation1 op1, BinaryOperation2 op2,
+    sycl::helpers::device_pointer<T> result) {
+  return inner_product_async(snp, first1, last1, first2, value, op1, op2,
+                             result.get());
+}
+
 
 #endif
 
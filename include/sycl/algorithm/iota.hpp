@@ -35,7 +35,7 @@ void iota(ExecutionPolicy &sep, ForwardIt b, ForwardIt e, const T &value = T(0))
           }
         });
   };
-  q.submit(f).wait();
+  sep.complete(q.submit(f));
 }
 
 }  // namespace impl
@@ -0,0 +1,140 @@
+#ifndef __SYCL_IMPL_ALGORITHM_MINMAX_ELEMENT__
+#define __SYCL_IMPL_ALGORITHM_MINMAX_ELEMENT__
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include <sycl/helpers/sycl_differences.hpp>
+#include <sycl/algorithm/buffer_algorithms.hpp>
+
+namespace sycl {
+namespace impl {
+
+namespace detail {
+
+/* Value packed with its position, the accumulator of min_element and
+ * max_element. ``index == size`` marks the empty accumulator used as init.
+ */
+template <typename T>
+struct indexed_value {
+  T value;
+  std::size_t index;
+};
+
+template <typename T>
+struct minmax_indexed_value {
+  indexed_value<T> min;
+  indexed_value<T> max;
+};
+
+/* Keeps the smallest value according to ``comp``, or the first one on ties
+ * when ``last_on_ties`` is false, the last one otherwise.
+ */
+template <typename T, typename Compare>
+indexed_value<T> select_indexed_value(const indexed_value<T> &a,
+                                      const indexed_value<T> &b,
+                                      std::size_t size, Compare comp,
+                                      bool last_on_ties) {
+  if (a.index == size)
+    return b;
+  if (b.index == size)
+    return a;
+  if (comp(a.value, b.value))
+    return a;
+  if (comp(b.value, a.value))
+    return b;
+  return ((a.index < b.index) != last_on_ties) ? a : b;
+}
+
+}  // namespace detail
+
+/* min_element.
+ * Single buffer_mapreduce over (value, index) pairs, keeping the first
+ * smallest element.
+ */
+template <typename ExecutionPolicy, typename ForwardIt, typename Compare>
+ForwardIt min_element(ExecutionPolicy &snp, ForwardIt first, ForwardIt last,
+                      Compare comp) {
+  const auto size = sycl::helpers::distance(first, last);
+  if (size <= 0) {
+    return last;
+  }
+  auto q = snp.get_queue();
+  auto device = q.get_device();
+  using value_type = typename std::iterator_traits<ForwardIt>::value_type;
+  using accumulator = detail::indexed_value<value_type>;
+
+  const auto d = compute_mapreduce_descriptor(device, size, sizeof(accumulator));
+
+  accumulator init{};
+  init.index = size;
+  const auto result = buffer_mapreduce(
+      snp, q, first, init, d,
+      [](std::size_t pos, value_type x) { return accumulator{x, pos}; },
+      [size, comp](accumulator a, accumulator b) {
+        return detail::select_indexed_value(a, b, size, comp, false);
+      });
+
+  return std::next(first, result.index);
+}
+
+/* max_element.
+ * Single buffer_mapreduce over (value, index) pairs, keeping the first
+ * largest element.
+ */
+template <typename ExecutionPolicy, typename ForwardIt, typename Compare>
+ForwardIt max_element(ExecutionPolicy &snp, ForwardIt first, ForwardIt last,
+                      Compare comp) {
+  using value_type = typename std::iterator_traits<ForwardIt>::value_type;
+  return ::sycl::impl::min_element(
+      snp, first, last,
+      [comp](const value_type &a, const value_type &b) { return comp(b, a); });
+}
+
+/* minmax_element.
+ * Both extrema are computed in the same pass, with a min and a max
+ * accumulator packed in one struct. As for std::minmax_element, the first
+ * smallest and the last largest elements are returned.
+ */
+template <typename ExecutionPolicy, typename ForwardIt, typename Compare>
+std::pair<ForwardIt, ForwardIt> minmax_element(ExecutionPolicy &snp,
+                                               ForwardIt first, ForwardIt last,
+                                               Compare comp) {
+  const auto size = sycl::helpers::distance(first, last);
+  if (size <= 0) {
+    return std::make_pair(last, last);
+  }
+  auto q = snp.get_queue();
+  auto device = q.get_device();
+  using value_type = typename std::iterator_traits<ForwardIt>::value_type;
+  using indexed = detail::indexed_value<value_type>;
+  using accumulator = detail::minmax_indexed_value<value_type>;
+
+  const auto d = compute_mapreduce_descriptor(device, size, sizeof(accumulator));
+
+  accumulator init{};
+  init.min.index = size;
+  init.max.index = size;
+  const auto result = buffer_mapreduce(
+      snp, q, first, init, d,
+      [](std::size_t pos, value_type x) {
+        return accumulator{indexed{x, pos}, indexed{x, pos}};
+      },
+      [size, comp](accumulator a, accumulator b) {
+        auto greater = [comp](const value_type &x, const value_type &y) {
+          return comp(y, x);
+        };
+        return accumulator{
+            detail::select_indexed_value(a.min, b.min, size, comp, false),
+            detail::select_indexed_value(a.max, b.max, size, greater, true)};
+      });
+
+  return std::make_pair(std::next(first, result.min.index),
+                        std::next(first, result.max.index));
+}
+
+}  // namespace impl
+}  // namespace sycl
+
+#endif  // __SYCL_IMPL_ALGORITHM_MINMAX_ELEMENT__
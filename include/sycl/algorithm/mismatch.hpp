@@ -30,10 +30,15 @@
 #define __SYCL_IMPL_ALGORITHM_MISMATCH__
 
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <type_traits>
 
 // SYCL helpers header
 #include <sycl/algorithm/algorithm_composite_patterns.hpp>
+#include <sycl/algorithm/buffer_algorithms.hpp>
 #include <sycl/helpers/sycl_buffers.hpp>
 #include <sycl/helpers/sycl_differences.hpp>
 #include <sycl/helpers/sycl_namegen.hpp>
@@ -130,6 +135,83 @@ std::pair<ForwardIt1, ForwardIt2> mismatch(ExecutionPolicy& exec,
 
 #else
 
+namespace detail {
+
+/* True when comparing the ranges with ``BinaryPredicate`` is the same as
+ * comparing their bytes: contiguous ranges of the same type, compared with
+ * std::equal_to, whose value is fully defined by its object representation.
+ */
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+constexpr bool is_bytewise_comparison() {
+  if constexpr (std::contiguous_iterator<ForwardIt1> &&
+                std::contiguous_iterator<ForwardIt2>) {
+    using value_type1 = typename std::iterator_traits<ForwardIt1>::value_type;
+    using value_type2 = typename std::iterator_traits<ForwardIt2>::value_type;
+    return std::is_same_v<value_type1, value_type2> &&
+           std::has_unique_object_representations_v<value_type1> &&
+           (std::is_same_v<BinaryPredicate, std::equal_to<>> ||
+            std::is_same_v<BinaryPredicate, std::equal_to<value_type1>>);
+  } else {
+    return false;
+  }
+}
+
+/* Position of the first pair of elements for which ``p`` is false among the
+ * first ``length`` ones, ``length`` if there is none.
+ * The search stops early through buffer_find_first. Bytewise comparable
+ * ranges aligned on 64 bits are compared word by word first, then the
+ * elements covered by the first different word, or the tail, are checked.
+ */
+template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
+          class BinaryPredicate>
+std::size_t first_difference(ExecutionPolicy &exec, cl::sycl::queue q,
+                             ForwardIt1 first1, ForwardIt2 first2,
+                             std::size_t length, BinaryPredicate p) {
+  using value_type1 = typename std::iterator_traits<ForwardIt1>::value_type;
+  using value_type2 = typename std::iterator_traits<ForwardIt2>::value_type;
+
+  auto element_test = [first1, first2, p](std::size_t pos) {
+    value_type1 x = first1[pos];
+    value_type2 y = first2[pos];
+    return !p(x, y);
+  };
+
+  if constexpr (is_bytewise_comparison<ForwardIt1, ForwardIt2,
+                                       BinaryPredicate>()) {
+    using word_type = std::uint64_t;
+    const value_type1 *ptr1 = std::to_address(first1);
+    const value_type2 *ptr2 = std::to_address(first2);
+    if (reinterpret_cast<std::uintptr_t>(ptr1) % alignof(word_type) == 0 &&
+        reinterpret_cast<std::uintptr_t>(ptr2) % alignof(word_type) == 0) {
+      const auto words1 = reinterpret_cast<const word_type *>(ptr1);
+      const auto words2 = reinterpret_cast<const word_type *>(ptr2);
+      const std::size_t nb_words = length * sizeof(value_type1) / sizeof(word_type);
+      const std::size_t word = buffer_find_first(
+          exec, q, nb_words,
+          [words1, words2](std::size_t pos) { return words1[pos] != words2[pos]; });
+
+      // elements left to check one by one
+      std::size_t begin, end;
+      if (word < nb_words) {
+        begin = word * sizeof(word_type) / sizeof(value_type1);
+        end = std::min(length, ((word + 1) * sizeof(word_type) - 1) /
+                                   sizeof(value_type1) + 1);
+      } else {
+        begin = nb_words * sizeof(word_type) / sizeof(value_type1);
+        end = length;
+      }
+      return begin + buffer_find_first(exec, q, end - begin,
+                                       [element_test, begin](std::size_t pos) {
+                                         return element_test(begin + pos);
+                                       });
+    }
+  }
+
+  return buffer_find_first(exec, q, length, element_test);
+}
+
+}  // namespace detail
+
 template <class ExecutionPolicy, class ForwardIt1, class ForwardIt2,
           class BinaryPredicate>
 std::pair<ForwardIt1, ForwardIt2> mismatch(ExecutionPolicy& exec,
@@ -147,21 +229,7 @@ std::pair<ForwardIt1, ForwardIt2> mismatch(ExecutionPolicy& exec,
 
   const auto q = exec.get_queue();
 
-  const auto device = q.get_device();
-  using value_type1 = typename std::iterator_traits<ForwardIt1>::value_type;
-  using value_type2 = typename std::iterator_traits<ForwardIt2>::value_type;
-
-  const auto d =
-      compute_mapreduce_descriptor(device, length, sizeof(value_type1));
-
-  const auto pos = buffer_map2reduce(
-      exec, q, first1, first2, length, d,
-      [p, length](std::size_t pos, value_type1 x, value_type2 y) {
-        return p(x, y) ? length : pos;
-      },
-      [](const std::size_t x, const std::size_t y) {
-        return cl::sycl::min(x, y);
-      });
+  const auto pos = detail::first_difference(exec, q, first1, first2, length, p);
 
   return std::make_pair(std::next(first1, pos), std::next(first2, pos));
 }
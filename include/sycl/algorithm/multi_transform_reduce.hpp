@@ -0,0 +1,123 @@
+#ifndef __SYCL_IMPL_ALGORITHM_MULTI_TRANSFORM_REDUCE__
+#define __SYCL_IMPL_ALGORITHM_MULTI_TRANSFORM_REDUCE__
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#include <sycl/helpers/sycl_differences.hpp>
+#include <sycl/algorithm/buffer_algorithms.hpp>
+
+namespace sycl {
+namespace impl {
+
+namespace detail {
+
+/* Accumulator of the fused reductions: a plain recursive struct holding one
+ * value per aggregate, so it stays trivially copyable and is stored in local
+ * memory as a single value, without the proxies of std::tuple / ZipIter.
+ */
+struct multi_accumulator_end {};
+
+template <typename B, typename Tail>
+struct multi_accumulator {
+  B head;
+  Tail tail;
+};
+
+/* The aggregates of a fused reduction, each given by a
+ * std::tuple<Map, Reduce, B> of its map and reduce functors and init value.
+ */
+template <typename... Aggregates>
+struct multi_aggregate {
+  using accumulator = multi_accumulator_end;
+
+  template <typename A>
+  accumulator map(const A &) const { return {}; }
+  accumulator reduce(const accumulator &, const accumulator &) const {
+    return {};
+  }
+  accumulator init() const { return {}; }
+  std::tuple<> to_tuple(const accumulator &) const { return {}; }
+};
+
+template <typename Map, typename Reduce, typename B, typename... Aggregates>
+struct multi_aggregate<std::tuple<Map, Reduce, B>, Aggregates...> {
+  using tail_type = multi_aggregate<Aggregates...>;
+  using accumulator = multi_accumulator<B, typename tail_type::accumulator>;
+
+  Map map_op;
+  Reduce reduce_op;
+  B init_value;
+  tail_type tail;
+
+  multi_aggregate(const std::tuple<Map, Reduce, B> &aggregate,
+                  const Aggregates &... aggregates)
+      : map_op(std::get<0>(aggregate)),
+        reduce_op(std::get<1>(aggregate)),
+        init_value(std::get<2>(aggregate)),
+        tail(aggregates...) {}
+
+  template <typename A>
+  accumulator map(const A &x) const {
+    return accumulator{static_cast<B>(map_op(x)), tail.map(x)};
+  }
+
+  accumulator reduce(const accumulator &a, const accumulator &b) const {
+    return accumulator{reduce_op(a.head, b.head), tail.reduce(a.tail, b.tail)};
+  }
+
+  accumulator init() const { return accumulator{init_value, tail.init()}; }
+
+  auto to_tuple(const accumulator &a) const {
+    return std::tuple_cat(std::make_tuple(a.head), tail.to_tuple(a.tail));
+  }
+};
+
+template <typename... Aggregates>
+multi_aggregate<Aggregates...> make_multi_aggregate(
+    const std::tuple<Aggregates...> &aggregates) {
+  return std::apply(
+      [](const Aggregates &... a) { return multi_aggregate<Aggregates...>(a...); },
+      aggregates);
+}
+
+}  // namespace detail
+
+/* multi_transform_reduce.
+ * Computes several transform_reduce of the same range in a single pass.
+ * ``aggregates`` is a std::tuple of std::tuple<Map, Reduce, T>, each giving
+ * the unary map, the binary reduce and the init value of one result, and the
+ * results are returned in a std::tuple in the same order.
+ * All the partial results of a work item are kept in one struct accumulator,
+ * so the input is read once and reduced with a single launch.
+ */
+template <typename ExecutionPolicy, typename InputIt, typename... Aggregates>
+auto multi_transform_reduce(ExecutionPolicy &snp, InputIt b, InputIt e,
+                            const std::tuple<Aggregates...> &aggregates) {
+  auto q = snp.get_queue();
+  auto device = q.get_device();
+  auto size = sycl::helpers::distance(b, e);
+  using value_type = typename std::iterator_traits<InputIt>::value_type;
+
+  const auto agg = detail::make_multi_aggregate(aggregates);
+  using accumulator = typename decltype(agg)::accumulator;
+
+  if (size <= 0)
+    return agg.to_tuple(agg.init());
+
+  auto d = compute_mapreduce_descriptor(device, size, sizeof(accumulator));
+
+  auto map = [agg](size_t, value_type x) { return agg.map(x); };
+  auto reduce = [agg](const accumulator &x, const accumulator &y) {
+    return agg.reduce(x, y);
+  };
+
+  return agg.to_tuple(buffer_mapreduce(snp, q, b, agg.init(), d, map, reduce));
+}
+
+}  // namespace impl
+}  // namespace sycl
+
+#endif  // __SYCL_IMPL_ALGORITHM_MULTI_TRANSFORM_REDUCE__
@@ -39,6 +39,7 @@
 #include <sycl/helpers/sycl_differences.hpp>
 #include <sycl/algorithm/algorithm_composite_patterns.hpp>
 #include <sycl/algorithm/buffer_algorithms.hpp>
+#include <sycl/helpers/sycl_device_future.hpp>
 #include <sycl/execution_policy>
 
 namespace sycl {
@@ -125,6 +126,43 @@ typename std::iterator_traits<Iterator>::value_type reduce(
   return buffer_mapreduce(snp, q, b, init, d, map, bop);
 }
 
+/*
+ * Asynchronous reduce, the result stays on the device until get() is called
+ * on the returned handle. If ``result`` is given, the value is written there.
+ */
+template <typename ExecutionPolicy,
+          typename Iterator,
+          typename T,
+          typename BinaryOperation>
+sycl::helpers::device_future<T> reduce_async(
+    ExecutionPolicy &snp, Iterator b, Iterator e, T init, BinaryOperation bop,
+    T *result = nullptr) {
+
+  auto q = snp.get_queue();
+  auto device = q.get_device();
+  auto size = sycl::helpers::distance(b, e);
+  using value_type = typename std::iterator_traits<Iterator>::value_type;
+
+  auto d = compute_mapreduce_descriptor(device, size, sizeof(value_type));
+
+  auto map = [](size_t, value_type x) { return x; };
+
+  return buffer_mapreduce_async(snp, q, b, init, d, map, bop, result);
+}
+
+/*
+ * reduce_async writing into a device_pointer
+ */
+template <typename ExecutionPolicy,
+          typename Iterator,
+          typename T,
+          typename BinaryOperation>
+sycl::helpers::device_future<T> reduce_async(
+    ExecutionPolicy &snp, Iterator b, Iterator e, T init, BinaryOperation bop,
+    sycl::helpers::device_pointer<T> result) {
+  return reduce_async(snp, b, e, init, bop, result.get());
+}
+
 #endif // __COMPUTECPP__
 
 }  // namespace impl
@@ -7,44 +7,27 @@
 
 // Detail header
 #include <sycl/helpers/sycl_buffers.hpp>
+#include <sycl/helpers/sycl_differences.hpp>
+#include <sycl/algorithm/buffer_algorithms.hpp>
 
 #include <functional>
-#include <vector>
-#include <boost/iterator/zip_iterator.hpp>
-#include <sycl/algorithm/exclusive_scan.hpp>
-#include <sycl/algorithm/scatter_if.hpp>
-#include <sycl/algorithm/transform.hpp>
-
-#include <ZipIterator.hpp>
-
-// reference: thrust/detail/generic/reduce_by_key.inl
+#include <iterator>
+#include <utility>
 
 namespace sycl {
 namespace impl {
 
-namespace detail
-{
-
-template <typename ValueType, typename TailFlagType, typename AssociativeOperator>
-struct reduce_by_key_functor
-{
-  AssociativeOperator binary_op;
-  
-  typedef typename std::tuple<ValueType, TailFlagType> result_type;
-
-  reduce_by_key_functor(AssociativeOperator _binary_op) : binary_op(_binary_op) {}
-
-  result_type operator()(result_type a, result_type b) const
-  {
-    return result_type(std::get<1>(b) ? std::get<0>(b) : binary_op(std::get<0>(a), std::get<0>(b)),
-                       std::get<1>(a) | std::get<1>(b));
-  }
-};
-
-
-} // end namespace detail
-
-
+/* reduce_by_key.
+ * Segmented reduction done in a single kernel, with the same chunk ordering
+ * as remove_copy_if: work groups grab their chunk with an atomic ticket and
+ * stage its keys and values in local memory. Every work item reduces a
+ * contiguous slice, counting the segment heads (positions where the key
+ * changes) and reducing the values since the last one; these
+ * (head count, value) pairs are scanned across the work group, then chained
+ * across chunks through a status array holding the number of heads and the
+ * value of the open segment at the end of every chunk. Each work item then
+ * writes the keys at the heads and the values at the tails of its slice.
+ */
 template<typename ExecutionPolicy,
          typename InputIterator1,
          typename InputIterator2,
@@ -62,51 +45,205 @@ std::pair<OutputIterator1, OutputIterator2>
                   BinaryPredicate binary_pred,
                   BinaryFunction binary_op)
 {
-    typedef unsigned int FlagType;  // TODO use difference_type
+    using KeyType = typename std::iterator_traits<InputIterator1>::value_type;
     using ValueType = typename std::iterator_traits<InputIterator2>::value_type;
 
-    if (keys_first == keys_last)
+    const size_t n = sycl::helpers::distance(keys_first, keys_last);
+    if (n == 0)
         return std::make_pair(keys_output, values_output);
 
     cl::sycl::queue queue = exec.get_queue();
+    const auto d = compute_mapscan_descriptor(queue.get_device(), n,
+                                              sizeof(KeyType) + sizeof(ValueType));
+    if ((d.nb_work_item == 0) || (d.nb_work_group == 0)) {
+        // the elements do not fit in local memory, keep it sequential
+        size_t count = 0;
+        ValueType acc{};
+        for (size_t pos = 0; pos < n; pos++) {
+            KeyType key = keys_first[pos];
+            ValueType x = values_first[pos];
+            if (pos == 0 || !binary_pred(KeyType(keys_first[pos - 1]), key)) {
+                if (pos > 0)
+                    values_output[count - 1] = acc;
+                keys_output[count++] = key;
+                acc = x;
+            } else {
+                acc = binary_op(acc, x);
+            }
+        }
+        values_output[count - 1] = acc;
+        return std::make_pair(std::next(keys_output, count),
+                              std::next(values_output, count));
+    }
+
+    // status[0] is the ticket counter, status[k + 1] holds the number of heads
+    // up to the end of chunk k plus one, 0 meaning "not published yet", and
+    // carries[k + 1] the value of the segment open at the end of chunk k
+    size_t* status =
+        sycl::helpers::make_temp_device_pointer<size_t, 0>(d.nb_work_group + 1, queue);
+    ValueType* carries =
+        sycl::helpers::make_temp_device_pointer<ValueType, 1>(d.nb_work_group + 1, queue);
+    queue.fill(status, size_t{0}, d.nb_work_group + 1).wait();
+
+    queue.submit([&](cl::sycl::handler &cgh) {
+        cl::sycl::range<1> rg{d.nb_work_group};
+        cl::sycl::range<1> ri{d.nb_work_item};
+        auto keys = keys_first;
+        auto values = values_first;
+        auto keys_out = keys_output;
+        auto values_out = values_output;
+        cl::sycl::accessor<KeyType, 1, cl::sycl::access::mode::read_write,
+                           cl::sycl::access::target::local>
+            chunk_keys{cl::sycl::range<1>(d.size_per_work_group + 1), cgh};
+        cl::sycl::accessor<ValueType, 1, cl::sycl::access::mode::read_write,
+                           cl::sycl::access::target::local>
+            chunk_values{cl::sycl::range<1>(d.size_per_work_group), cgh};
+        cl::sycl::accessor<size_t, 1, cl::sycl::access::mode::read_write,
+                           cl::sycl::access::target::local>
+            heads{cl::sycl::range<1>(d.nb_work_item), cgh};
+        cl::sycl::accessor<ValueType, 1, cl::sycl::access::mode::read_write,
+                           cl::sycl::access::target::local>
+            partials{cl::sycl::range<1>(d.nb_work_item + 1), cgh};
+        cl::sycl::accessor<size_t, 1, cl::sycl::access::mode::read_write,
+                           cl::sycl::access::target::local>
+            shared{cl::sycl::range<1>(2), cgh};
+        cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                         [=](cl::sycl::nd_item<1> nd_item) {
+            using status_ref =
+                cl::sycl::atomic_ref<size_t, cl::sycl::memory_order::relaxed,
+                                     cl::sycl::memory_scope::device,
+                                     cl::sycl::access::address_space::global_space>;
+            const size_t local_id = nd_item.get_local_id(0);
+
+            if (local_id == 0) {
+                shared[0] = status_ref(status[0]).fetch_add(size_t{1});
+            }
+            nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+            const size_t chunk_id = shared[0];
+            const size_t chunk_begin = chunk_id * d.size_per_work_group;
+            const size_t chunk_size =
+                std::min(d.size_per_work_group, d.size - chunk_begin);
+
+            // coalesced load of the chunk, with the key following it
+            for (size_t pos = local_id; pos < chunk_size; pos += d.nb_work_item) {
+                chunk_keys[pos] = keys[chunk_begin + pos];
+                chunk_values[pos] = values[chunk_begin + pos];
+            }
+            if (local_id == 0 && chunk_begin + chunk_size < d.size) {
+                chunk_keys[chunk_size] = keys[chunk_begin + chunk_size];
+            }
+            nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+            auto is_head = [&](size_t pos) {
+                if (pos == 0) {
+                    return chunk_begin == 0 ||
+                           !binary_pred(KeyType(keys[chunk_begin - 1]), chunk_keys[0]);
+                }
+                return !binary_pred(chunk_keys[pos - 1], chunk_keys[pos]);
+            };
+            auto is_tail = [&](size_t pos) {
+                return (chunk_begin + pos + 1 == d.size) ||
+                       !binary_pred(chunk_keys[pos], chunk_keys[pos + 1]);
+            };
+
+            // every work item owns a contiguous slice, empty ones are last
+            const size_t item_begin =
+                std::min(local_id * d.size_per_work_item, chunk_size);
+            const size_t item_end =
+                std::min(item_begin + d.size_per_work_item, chunk_size);
+            const size_t last_item = (chunk_size - 1) / d.size_per_work_item;
+            size_t item_heads = 0;
+            ValueType item_value{};
+            for (size_t pos = item_begin; pos < item_end; pos++) {
+                if (is_head(pos)) {
+                    item_heads++;
+                    item_value = chunk_values[pos];
+                } else {
+                    item_value = (pos == item_begin)
+                                     ? chunk_values[pos]
+                                     : binary_op(item_value, chunk_values[pos]);
+                }
+            }
+            heads[local_id] = item_heads;
+            partials[local_id + 1] = item_value;
+            nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+            // inclusive segmented scan of the (head count, value) pairs of the
+            // non-empty slices: a pair restarts the value when it has a head
+            for (size_t offset = 1; offset <= last_item; offset <<= 1) {
+                const bool combine = local_id >= offset && local_id <= last_item;
+                size_t other_heads = 0;
+                ValueType other_value{};
+                if (combine) {
+                    other_heads = heads[local_id - offset];
+                    other_value = partials[local_id - offset + 1];
+                }
+                nd_item.barrier(cl::sycl::access::fence_space::local_space);
+                if (combine) {
+                    if (heads[local_id] == 0) {
+                        partials[local_id + 1] =
+                            binary_op(other_value, partials[local_id + 1]);
+                    }
+                    heads[local_id] += other_heads;
+                }
+                nd_item.barrier(cl::sycl::access::fence_space::local_space);
+            }
+
+            if (local_id == 0) {
+                size_t chunk_heads = 0;
+                if (chunk_id > 0) {
+                    size_t published = 0;
+                    while ((published = status_ref(status[chunk_id]).load(
+                                cl::sycl::memory_order::acquire)) == 0) {
+                    }
+                    chunk_heads = published - 1;
+                    // the value of the segment open before the chunk
+                    partials[0] = carries[chunk_id];
+                }
+                const ValueType chunk_value = partials[last_item + 1];
+                carries[chunk_id + 1] =
+                    (heads[last_item] == 0) ? binary_op(partials[0], chunk_value)
+                                            : chunk_value;
+                status_ref(status[chunk_id + 1]).store(
+                    chunk_heads + heads[last_item] + 1,
+                    cl::sycl::memory_order::release);
+                shared[1] = chunk_heads;
+            }
+            nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+            if (item_begin < item_end) {
+                // state before the slice: heads so far and open segment value
+                size_t count = shared[1];
+                ValueType acc{};
+                if (local_id == 0) {
+                    acc = partials[0];
+                } else {
+                    count += heads[local_id - 1];
+                    const ValueType previous = partials[local_id];
+                    acc = (heads[local_id - 1] == 0)
+                              ? binary_op(partials[0], previous)
+                              : previous;
+                }
+                for (size_t pos = item_begin; pos < item_end; pos++) {
+                    if (is_head(pos)) {
+                        keys_out[count++] = chunk_keys[pos];
+                        acc = chunk_values[pos];
+                    } else {
+                        acc = binary_op(acc, chunk_values[pos]);
+                    }
+                    if (is_tail(pos)) {
+                        values_out[count - 1] = acc;
+                    }
+                }
+            }
+        });
+    }).wait();
 
-    // input size
-    auto n = keys_last - keys_first;
-
-    InputIterator2 values_last = values_first + n;
-    
-    // compute head flags
-    FlagType* head_flags = sycl::helpers::make_temp_device_pointer<FlagType, 1>(n, queue);
-    sycl::impl::transform(exec, keys_first, keys_last - 1, keys_first + 1, head_flags + 1, std::not_fn(binary_pred));
-    sycl::helpers::write_device_pointer(head_flags + 0, static_cast<FlagType>(1), queue); // head_flags[0] = 1;
-
-    // compute tail flags
-    FlagType* tail_flags = sycl::helpers::make_temp_device_pointer<FlagType, 2>(n, queue); //COPY INSTEAD OF TRANSFORM
-    sycl::impl::transform(exec, keys_first, keys_last - 1, keys_first + 1, tail_flags, std::not_fn(binary_pred));
-    sycl::helpers::write_device_pointer(tail_flags + (n - 1), static_cast<FlagType>(1), queue); // tail_flags[n-1] = 1;
-
-    // scan the values by flag
-    ValueType* scanned_values = sycl::helpers::make_temp_device_pointer<ValueType, 0>(n, queue);
-    FlagType* scanned_tail_flags = sycl::helpers::make_temp_device_pointer<FlagType, 3>(n, queue);
-    
-    sycl::impl::inclusive_scan
-        (exec,
-         ZipIter(values_first,           head_flags),
-         ZipIter(values_first + n,       head_flags + n),
-         ZipIter(scanned_values,         scanned_tail_flags),
-         std::tuple(ValueType(), FlagType()),
-         detail::reduce_by_key_functor<ValueType, FlagType, BinaryFunction>(binary_op));
-
-    sycl::impl::exclusive_scan(exec, tail_flags, tail_flags + n, scanned_tail_flags, FlagType(0), std::plus<FlagType>());
-
-    // number of unique keys
-    FlagType N = sycl::helpers::read_device_pointer(scanned_tail_flags + (n - 1), queue) + 1;// scanned_tail_flags[n - 1] + 1;
-    
-    // scatter the keys and accumulated values    
-    sycl::impl::scatter_if(exec, keys_first,     keys_last,          scanned_tail_flags, head_flags, keys_output);
-    sycl::impl::scatter_if(exec, scanned_values, scanned_values + n, scanned_tail_flags, tail_flags, values_output);
-
-    return std::make_pair(keys_output + N, values_output + N); 
+    const size_t count =
+        sycl::helpers::read_device_pointer(status + d.nb_work_group, queue) - 1;
+    return std::make_pair(std::next(keys_output, count),
+                          std::next(values_output, count));
 } // end reduce_by_key()
 
 
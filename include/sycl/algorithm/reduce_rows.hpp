@@ -0,0 +1,194 @@
+#ifndef __SYCL_IMPL_ALGORITHM_REDUCE_ROWS__
+#define __SYCL_IMPL_ALGORITHM_REDUCE_ROWS__
+
+#include <algorithm>
+#include <iterator>
+
+#include <sycl/algorithm/buffer_algorithms.hpp>
+
+namespace sycl {
+namespace impl {
+
+/* reduce_lines_in_global.
+ * Reduces ``lines`` lines of ``length`` elements into ``result[line]``, the
+ * element ``k`` of a line being ``line * line_step + k * step`` elements past
+ * ``first``. Each line is reduced by a single work item without local
+ * memory, for the values too large for the local memory of a work group.
+ */
+template <class InputIt, class OutputIt, class T, class BinaryOperation>
+void reduce_lines_in_global(cl::sycl::queue q, InputIt first, size_t lines,
+                            size_t length, size_t line_step, size_t step,
+                            OutputIt result, T init, BinaryOperation bop) {
+  const size_t nb_work_item = std::min(max_work_item_count(q.get_device()),
+                                       lines);
+  q.submit([&](cl::sycl::handler &cgh) {
+    cl::sycl::range<1> rg{up_rounded_division(lines, nb_work_item)};
+    cl::sycl::range<1> ri{nb_work_item};
+    auto input = first;
+    auto output = result;
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                     [=](cl::sycl::nd_item<1> nd_item) {
+      const size_t line = nd_item.get_global_id(0);
+      if (line < lines) {
+        T acc = init;
+        for (size_t k = 0; k < length; k++) {
+          acc = bop(acc, input[line * line_step + k * step]);
+        }
+        output[line] = acc;
+      }
+    });
+  }).wait();
+}
+
+/* reduce_rows.
+ * Reduces every row of the row-major matrix starting at ``first`` into
+ * ``result[row]``, for ``rows`` rows of ``cols`` elements, consecutive rows
+ * being ``stride`` elements apart.
+ * Everything is done in a single kernel: a row is handled by a power of two
+ * count of adjacent work items, so several short rows share a work group,
+ * each of them reading consecutive columns and combining their partials in
+ * local memory with a tree. The work groups are kept small enough for their
+ * partials to fit in local memory, and values too large for it are reduced
+ * by reduce_lines_in_global.
+ */
+template <class ExecutionPolicy, class InputIt, class OutputIt, class T,
+          class BinaryOperation>
+OutputIt reduce_rows(ExecutionPolicy &sep, InputIt first, size_t rows,
+                     size_t cols, size_t stride, OutputIt result, T init,
+                     BinaryOperation bop) {
+  if (rows == 0) {
+    return result;
+  }
+  cl::sycl::queue q(sep.get_queue());
+  const size_t max_local_item =
+      max_local_work_item_count(q.get_device(), sizeof(T));
+  if (max_local_item == 0) {
+    reduce_lines_in_global(q, first, rows, cols, stride, 1, result, init, bop);
+    return std::next(result, rows);
+  }
+  const size_t max_work_item = round_down_power_of_two(max_local_item);
+  // work items per row and rows per work group
+  const size_t lanes = std::min(max_work_item, round_up_power_of_two(cols));
+  const size_t rows_per_group =
+      std::min(max_work_item / lanes, round_up_power_of_two(rows));
+  const size_t nb_work_item = lanes * rows_per_group;
+  const size_t nb_work_group = up_rounded_division(rows, rows_per_group);
+  const size_t valid_lanes = std::min(lanes, cols);
+
+  q.submit([&](cl::sycl::handler &cgh) {
+    cl::sycl::range<1> rg{nb_work_group};
+    cl::sycl::range<1> ri{nb_work_item};
+    auto input = first;
+    auto output = result;
+    cl::sycl::accessor<T, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+        scratch{cl::sycl::range<1>(nb_work_item), cgh};
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                     [=](cl::sycl::nd_item<1> nd_item) {
+      const size_t local_id = nd_item.get_local_id(0);
+      const size_t lane = local_id % lanes;
+      const size_t row = nd_item.get_group(0) * rows_per_group + local_id / lanes;
+
+      if (row < rows && lane < cols) {
+        const auto row_begin = row * stride;
+        T acc = input[row_begin + lane];
+        for (size_t col = lane + lanes; col < cols; col += lanes) {
+          acc = bop(acc, input[row_begin + col]);
+        }
+        scratch[local_id] = acc;
+      }
+      nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+      for (size_t offset = lanes >> 1; offset > 0; offset >>= 1) {
+        if (row < rows && lane < offset && lane + offset < valid_lanes) {
+          scratch[local_id] = bop(scratch[local_id], scratch[local_id + offset]);
+        }
+        nd_item.barrier(cl::sycl::access::fence_space::local_space);
+      }
+
+      if (row < rows && lane == 0) {
+        output[row] = (cols > 0) ? bop(init, scratch[local_id]) : init;
+      }
+    });
+  }).wait();
+
+  return std::next(result, rows);
+}
+
+/* reduce_cols.
+ * Reduces every column of the row-major matrix starting at ``first`` into
+ * ``result[col]``, see reduce_rows for the layout.
+ * Adjacent work items handle adjacent columns so reads stay coalesced; when
+ * there are fewer columns than work items in a group, the remaining work
+ * items split the rows and their partials are combined in local memory.
+ */
+template <class ExecutionPolicy, class InputIt, class OutputIt, class T,
+          class BinaryOperation>
+OutputIt reduce_cols(ExecutionPolicy &sep, InputIt first, size_t rows,
+                     size_t cols, size_t stride, OutputIt result, T init,
+                     BinaryOperation bop) {
+  if (cols == 0) {
+    return result;
+  }
+  cl::sycl::queue q(sep.get_queue());
+  const size_t max_local_item =
+      max_local_work_item_count(q.get_device(), sizeof(T));
+  if (max_local_item == 0) {
+    reduce_lines_in_global(q, first, cols, rows, 1, stride, result, init, bop);
+    return std::next(result, cols);
+  }
+  const size_t max_work_item = round_down_power_of_two(max_local_item);
+  // columns per work group and work items per column
+  const size_t cols_per_group = std::min(max_work_item, cols);
+  const size_t lanes = std::min(
+      round_down_power_of_two(max_work_item / cols_per_group),
+      round_up_power_of_two(rows));
+  const size_t nb_work_item = lanes * cols_per_group;
+  const size_t nb_work_group = up_rounded_division(cols, cols_per_group);
+  const size_t valid_lanes = std::min(lanes, rows);
+
+  q.submit([&](cl::sycl::handler &cgh) {
+    cl::sycl::range<1> rg{nb_work_group};
+    cl::sycl::range<1> ri{nb_work_item};
+    auto input = first;
+    auto output = result;
+    cl::sycl::accessor<T, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+        scratch{cl::sycl::range<1>(nb_work_item), cgh};
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                     [=](cl::sycl::nd_item<1> nd_item) {
+      const size_t local_id = nd_item.get_local_id(0);
+      const size_t lane = local_id / cols_per_group;
+      const size_t col_in_group = local_id % cols_per_group;
+      const size_t col = nd_item.get_group(0) * cols_per_group + col_in_group;
+
+      if (col < cols && lane < rows) {
+        T acc = input[lane * stride + col];
+        for (size_t row = lane + lanes; row < rows; row += lanes) {
+          acc = bop(acc, input[row * stride + col]);
+        }
+        scratch[local_id] = acc;
+      }
+      nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+      for (size_t offset = lanes >> 1; offset > 0; offset >>= 1) {
+        if (col < cols && lane < offset && lane + offset < valid_lanes) {
+          scratch[local_id] = bop(scratch[local_id],
+                                  scratch[local_id + offset * cols_per_group]);
+        }
+        nd_item.barrier(cl::sycl::access::fence_space::local_space);
+      }
+
+      if (col < cols && lane == 0) {
+        output[col] = (rows > 0) ? bop(init, scratch[local_id]) : init;
+      }
+    });
+  }).wait();
+
+  return std::next(result, cols);
+}
+
+}  // namespace impl
+}  // namespace sycl
+
+#endif  // __SYCL_IMPL_ALGORITHM_REDUCE_ROWS__
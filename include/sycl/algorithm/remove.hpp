@@ -0,0 +1,214 @@
+#ifndef __SYCL_IMPL_ALGORITHM_REMOVE__
+#define __SYCL_IMPL_ALGORITHM_REMOVE__
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include <sycl/helpers/sycl_buffers.hpp>
+#include <sycl/helpers/sycl_differences.hpp>
+#include <sycl/algorithm/buffer_algorithms.hpp>
+#include <sycl/algorithm/copy.hpp>
+
+namespace sycl {
+namespace impl {
+
+namespace detail {
+
+/* Returns true when writing the compacted sequence through ``d_first`` could
+ * clobber elements of ``[first, last)`` that have not been read yet, i.e. when
+ * the destination starts strictly inside the source range.
+ * Writing to ``d_first <= first`` is always safe with the ordered chunks used
+ * by remove_copy_if, as every chunk only writes at or before its own end.
+ * Only contiguous iterators can be compared, the others are assumed not to
+ * overlap as required by std::remove_copy_if.
+ */
+template <class InputIt, class OutputIt>
+bool remove_copy_needs_temp(InputIt first, InputIt last, OutputIt d_first) {
+  if constexpr (std::contiguous_iterator<InputIt> &&
+                std::contiguous_iterator<OutputIt>) {
+    const auto in_begin = std::to_address(first);
+    const auto in_end = std::to_address(last);
+    const auto out_begin = std::to_address(d_first);
+    if constexpr (std::is_same_v<decltype(in_begin), decltype(out_begin)>) {
+      return (in_begin < out_begin) && (out_begin < in_end);
+    }
+  }
+  return false;
+}
+
+}  // namespace detail
+
+/* remove_copy_if.
+ * Stream compaction done in a single kernel. Work-groups grab their chunk with
+ * an atomic ticket, so chunk ``k`` is always handled by a work-group that
+ * started after the one handling chunk ``k - 1``. Every work-group stages its
+ * chunk in local memory, waits for the output offset published by its
+ * predecessor, publishes its own and then writes the kept elements.
+ * Since a chunk is fully read before its offset is published and a chunk never
+ * writes past its own end, the output may alias the input as long as
+ * ``d_first <= first``; otherwise the input is copied to a temporary first.
+ */
+template <class ExecutionPolicy, class InputIt, class OutputIt,
+          class UnaryPredicate>
+OutputIt remove_copy_if(ExecutionPolicy &sep, InputIt first, InputIt last,
+                        OutputIt d_first, UnaryPredicate p) {
+  using value_type = typename std::iterator_traits<InputIt>::value_type;
+
+  cl::sycl::queue q(sep.get_queue());
+  const auto device = q.get_device();
+  const size_t n = sycl::helpers::distance(first, last);
+  if (n == 0) {
+    return d_first;
+  }
+
+  if (detail::remove_copy_needs_temp(first, last, d_first)) {
+    value_type* tmp =
+        sycl::helpers::make_temp_device_pointer<value_type, 1>(n, q);
+    ::sycl::impl::copy(sep, first, last, tmp);
+    return ::sycl::impl::remove_copy_if(sep, tmp, tmp + n, d_first, p);
+  }
+
+  auto d = compute_mapscan_descriptor(device, n, sizeof(value_type));
+  if ((d.nb_work_item == 0) || (d.nb_work_group == 0)) {
+    // the element type does not fit in local memory, keep it sequential
+    auto out = d_first;
+    size_t kept = 0;
+    for (size_t pos = 0; pos < n; pos++) {
+      value_type x = first[pos];
+      if (!p(x)) {
+        out[kept++] = x;
+      }
+    }
+    return std::next(d_first, kept);
+  }
+
+  // status[0] is the ticket counter, status[k + 1] holds the inclusive output
+  // offset of chunk k plus one, 0 meaning "not published yet"
+  size_t* status =
+      sycl::helpers::make_temp_device_pointer<size_t, 0>(d.nb_work_group + 1, q);
+  q.fill(status, size_t{0}, d.nb_work_group + 1).wait();
+
+  q.submit([&](cl::sycl::handler &cgh) {
+    cl::sycl::range<1> rg{d.nb_work_group};
+    cl::sycl::range<1> ri{d.nb_work_item};
+    auto input = first;
+    auto output = d_first;
+    cl::sycl::accessor<value_type, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+        chunk{cl::sycl::range<1>(d.size_per_work_group), cgh};
+    cl::sycl::accessor<size_t, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+        counts{cl::sycl::range<1>(d.nb_work_item), cgh};
+    cl::sycl::accessor<size_t, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+        shared{cl::sycl::range<1>(2), cgh};
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                     [=](cl::sycl::nd_item<1> nd_item) {
+      using status_ref =
+          cl::sycl::atomic_ref<size_t, cl::sycl::memory_order::relaxed,
+                               cl::sycl::memory_scope::device,
+                               cl::sycl::access::address_space::global_space>;
+      const size_t local_id = nd_item.get_local_id(0);
+
+      if (local_id == 0) {
+        shared[0] = status_ref(status[0]).fetch_add(size_t{1});
+      }
+      nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+      const size_t chunk_id = shared[0];
+      const size_t chunk_begin = chunk_id * d.size_per_work_group;
+      const size_t chunk_size =
+          std::min(d.size_per_work_group, d.size - chunk_begin);
+
+      // coalesced load of the chunk
+      for (size_t pos = local_id; pos < chunk_size; pos += d.nb_work_item) {
+        chunk[pos] = input[chunk_begin + pos];
+      }
+      nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+      // every work item owns a contiguous slice, to keep the order stable
+      const size_t item_begin =
+          std::min(local_id * d.size_per_work_item, chunk_size);
+      const size_t item_end =
+          std::min(item_begin + d.size_per_work_item, chunk_size);
+      size_t kept = 0;
+      for (size_t pos = item_begin; pos < item_end; pos++) {
+        kept += p(chunk[pos]) ? 0 : 1;
+      }
+      counts[local_id] = kept;
+      nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+      // inclusive scan of the per work item counts
+      for (size_t offset = 1; offset < d.nb_work_item; offset <<= 1) {
+        const size_t other = (local_id >= offset) ? counts[local_id - offset] : 0;
+        nd_item.barrier(cl::sycl::access::fence_space::local_space);
+        counts[local_id] += other;
+        nd_item.barrier(cl::sycl::access::fence_space::local_space);
+      }
+
+      if (local_id == 0) {
+        size_t chunk_offset = 0;
+        if (chunk_id > 0) {
+          size_t published = 0;
+          while ((published = status_ref(status[chunk_id]).load(
+                      cl::sycl::memory_order::acquire)) == 0) {
+          }
+          chunk_offset = published - 1;
+        }
+        status_ref(status[chunk_id + 1]).store(
+            chunk_offset + counts[d.nb_work_item - 1] + 1,
+            cl::sycl::memory_order::release);
+        shared[1] = chunk_offset;
+      }
+      nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+      size_t write = shared[1] + counts[local_id] - kept;
+      for (size_t pos = item_begin; pos < item_end; pos++) {
+        if (!p(chunk[pos])) {
+          output[write++] = chunk[pos];
+        }
+      }
+    });
+  }).wait();
+
+  const size_t kept =
+      sycl::helpers::read_device_pointer(status + d.nb_work_group, q) - 1;
+  return std::next(d_first, kept);
+}
+
+/* remove_copy.
+ * Forwards to remove_copy_if with an equality predicate.
+ */
+template <class ExecutionPolicy, class InputIt, class OutputIt, class T>
+OutputIt remove_copy(ExecutionPolicy &sep, InputIt first, InputIt last,
+                     OutputIt d_first, const T &value) {
+  // copy value, as we cannot capture it by reference
+  const T val = value;
+  return ::sycl::impl::remove_copy_if(sep, first, last, d_first,
+                                      [val](const auto &x) { return x == val; });
+}
+
+/* remove_if.
+ * In-place compaction, see remove_copy_if.
+ */
+template <class ExecutionPolicy, class ForwardIt, class UnaryPredicate>
+ForwardIt remove_if(ExecutionPolicy &sep, ForwardIt first, ForwardIt last,
+                    UnaryPredicate p) {
+  return ::sycl::impl::remove_copy_if(sep, first, last, first, p);
+}
+
+/* remove.
+ * In-place compaction, see remove_copy_if.
+ */
+template <class ExecutionPolicy, class ForwardIt, class T>
+ForwardIt remove(ExecutionPolicy &sep, ForwardIt first, ForwardIt last,
+                 const T &value) {
+  return ::sycl::impl::remove_copy(sep, first, last, first, value);
+}
+
+}  // namespace impl
+}  // namespace sycl
+
+#endif  // __SYCL_IMPL_ALGORITHM_REMOVE__
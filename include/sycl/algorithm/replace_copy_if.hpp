@@ -77,7 +77,7 @@ ForwardIt2 replace_copy_if(ExecutionPolicy &sep, ForwardIt1 first,
           }
         });
   };
-  q.submit(f).wait();
+  sep.complete(q.submit(f));
 
   return d_last;
 }
@@ -67,7 +67,7 @@ void replace_if(ExecutionPolicy &sep, ForwardIt first, ForwardIt last,
           }
         });
   };
-  q.submit(f).wait();
+  sep.complete(q.submit(f));
 }
 
 }  // namespace impl
@@ -61,7 +61,7 @@ void reverse(ExecutionPolicy &sep, BidirIt first, BidirIt last) {
           }
         });
   };
-  q.submit(f).wait();
+  sep.complete(q.submit(f));
 }
 
 }  // namespace impl
@@ -66,7 +66,7 @@ ForwardIt reverse_copy(ExecutionPolicy &sep, BidirIt first, BidirIt last,
           }
         });
   };
-  q.submit(f).wait();
+  sep.complete(q.submit(f));
 
   return d_last;
 }
@@ -51,7 +51,7 @@ ForwardIt2 rotate_copy(ExecutionPolicy &sep, ForwardIt1 first,
   using value_type = typename std::iterator_traits<ForwardIt1>::value_type;
 {
   const auto rot_n = std::distance(first, middle);
-  sep.get_queue().submit([n, rot_n, first, result](handler &h) {
+  sep.complete(sep.get_queue().submit([n, rot_n, first, result](handler &h) {
 
     auto aI = first;
     auto aO = result;
@@ -62,7 +62,7 @@ ForwardIt2 rotate_copy(ExecutionPolicy &sep, ForwardIt1 first,
                                  i.get_id(0) + rot_n;
       aO[i.get_id(0)] = aI[rotated_id];
     });
-  }).wait();
+  }));
 }
   return std::next(result, n);
 }
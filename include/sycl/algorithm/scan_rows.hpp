@@ -0,0 +1,138 @@
+#ifndef __SYCL_IMPL_ALGORITHM_SCAN_ROWS__
+#define __SYCL_IMPL_ALGORITHM_SCAN_ROWS__
+
+#include <algorithm>
+#include <iterator>
+
+#include <sycl/algorithm/buffer_algorithms.hpp>
+
+namespace sycl {
+namespace impl {
+
+/* scan_rows_in_global.
+ * scan_rows with a single work item per row and no local memory, for the
+ * values too large for the local memory of a work group.
+ */
+template <class InputIt, class OutputIt, class BinaryOperation>
+void scan_rows_in_global(cl::sycl::queue q, InputIt first, size_t rows,
+                         size_t cols, size_t stride, OutputIt result,
+                         BinaryOperation bop) {
+  using value_type = typename std::iterator_traits<OutputIt>::value_type;
+  const size_t nb_work_item = std::min(max_work_item_count(q.get_device()),
+                                       rows);
+  q.submit([&](cl::sycl::handler &cgh) {
+    cl::sycl::range<1> rg{up_rounded_division(rows, nb_work_item)};
+    cl::sycl::range<1> ri{nb_work_item};
+    auto input = first;
+    auto output = result;
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                     [=](cl::sycl::nd_item<1> nd_item) {
+      const size_t row = nd_item.get_global_id(0);
+      if (row < rows) {
+        const auto row_begin = row * stride;
+        value_type carry = input[row_begin];
+        output[row_begin] = carry;
+        for (size_t col = 1; col < cols; col++) {
+          carry = bop(carry, input[row_begin + col]);
+          output[row_begin + col] = carry;
+        }
+      }
+    });
+  }).wait();
+}
+
+/* scan_rows.
+ * Inclusive scan of every row of the row-major matrix starting at ``first``,
+ * for ``rows`` rows of ``cols`` elements, consecutive rows being ``stride``
+ * elements apart. ``result`` uses the same layout and may be ``first``.
+ * Everything is done in a single kernel: a row is handled by a power of two
+ * count of adjacent work items which walk it tile by tile, scanning each tile
+ * in local memory and carrying the running total to the next one. The work
+ * groups are kept small enough for their tiles to fit in local memory, and
+ * values too large for it are scanned by scan_rows_in_global.
+ * Returns the iterator ``rows * stride`` elements past ``result``.
+ */
+template <class ExecutionPolicy, class InputIt, class OutputIt,
+          class BinaryOperation>
+OutputIt scan_rows(ExecutionPolicy &sep, InputIt first, size_t rows,
+                   size_t cols, size_t stride, OutputIt result,
+                   BinaryOperation bop) {
+  using value_type = typename std::iterator_traits<OutputIt>::value_type;
+  if (rows == 0 || cols == 0) {
+    return std::next(result, rows * stride);
+  }
+  cl::sycl::queue q(sep.get_queue());
+  const size_t max_local_item =
+      max_local_work_item_count(q.get_device(), sizeof(value_type));
+  if (max_local_item == 0) {
+    scan_rows_in_global(q, first, rows, cols, stride, result, bop);
+    return std::next(result, rows * stride);
+  }
+  const size_t max_work_item = round_down_power_of_two(max_local_item);
+  // work items per row and rows per work group
+  const size_t lanes = std::min(max_work_item, round_up_power_of_two(cols));
+  const size_t rows_per_group =
+      std::min(max_work_item / lanes, round_up_power_of_two(rows));
+  const size_t nb_work_item = lanes * rows_per_group;
+  const size_t nb_work_group = up_rounded_division(rows, rows_per_group);
+  const size_t nb_tiles = up_rounded_division(cols, lanes);
+
+  q.submit([&](cl::sycl::handler &cgh) {
+    cl::sycl::range<1> rg{nb_work_group};
+    cl::sycl::range<1> ri{nb_work_item};
+    auto input = first;
+    auto output = result;
+    cl::sycl::accessor<value_type, 1, cl::sycl::access::mode::read_write,
+                       cl::sycl::access::target::local>
+        scratch{cl::sycl::range<1>(nb_work_item), cgh};
+    cgh.parallel_for(cl::sycl::nd_range<1>(rg * ri, ri),
+                     [=](cl::sycl::nd_item<1> nd_item) {
+      const size_t local_id = nd_item.get_local_id(0);
+      const size_t lane = local_id % lanes;
+      const size_t row_first_id = local_id - lane;
+      const size_t row = nd_item.get_group(0) * rows_per_group + local_id / lanes;
+      const bool active_row = row < rows;
+      const auto row_begin = row * stride;
+
+      value_type carry{};
+      for (size_t tile = 0; tile < nb_tiles; tile++) {
+        const size_t col = tile * lanes + lane;
+        const bool active = active_row && col < cols;
+        if (active) {
+          scratch[local_id] = input[row_begin + col];
+        }
+        nd_item.barrier(cl::sycl::access::fence_space::local_space);
+
+        // Hillis-Steele scan, inactive lanes are always at the end of a row
+        for (size_t offset = 1; offset < lanes; offset <<= 1) {
+          value_type other{};
+          if (active && lane >= offset) {
+            other = scratch[local_id - offset];
+          }
+          nd_item.barrier(cl::sycl::access::fence_space::local_space);
+          if (active && lane >= offset) {
+            scratch[local_id] = bop(other, scratch[local_id]);
+          }
+          nd_item.barrier(cl::sycl::access::fence_space::local_space);
+        }
+
+        if (active) {
+          const size_t last_lane = std::min(lanes, cols - tile * lanes) - 1;
+          const value_type value = scratch[local_id];
+          const value_type tile_total = scratch[row_first_id + last_lane];
+          output[row_begin + col] = (tile > 0) ? bop(carry, value) : value;
+          carry = (tile > 0) ? bop(carry, tile_total) : tile_total;
+        }
+        // the next tile overwrites the scratch
+        nd_item.barrier(cl::sycl::access::fence_space::local_space);
+      }
+    });
+  }).wait();
+
+  return std::next(result, rows * stride);
+}
+
+}  // namespace impl
+}  // namespace sycl
+
+#endif  // __SYCL_IMPL_ALGORITHM_SCAN_ROWS__
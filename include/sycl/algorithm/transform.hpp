@@ -70,7 +70,7 @@ OutputIterator transform(ExecutionPolicy &sep, Iterator b, Iterator e,
             }
           });
     };
-    q.submit(f).wait();
+    sep.complete(q.submit(f));
     return out + n;
   }
 }
@@ -105,7 +105,7 @@ OutputIterator transform(ExecutionPolicy &sep, InputIterator1 first1,
           }
         });
   };
-  q.submit(f).wait();
+  sep.complete(q.submit(f));
   return result + n;
 }
 
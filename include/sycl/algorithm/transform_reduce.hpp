@@ -131,6 +131,76 @@ T transform_reduce(ExecutionPolicy& snp, InputIt b,
 
 }
 
+/*
+ * Binary transform_reduce: reduces with ``reduce_op`` the results of
+ * ``transform_op`` applied to the pairs of elements of [first1, last1) and
+ * the range starting at ``first2``, in a single buffer_map2reduce.
+ */
+template <typename ExecutionPolicy, typename InputIt1, typename InputIt2,
+          typename T, typename BinaryReduceOp, typename BinaryTransformOp>
+T transform_reduce(ExecutionPolicy& snp, InputIt1 first1, InputIt1 last1,
+                   InputIt2 first2, T init, BinaryReduceOp reduce_op,
+                   BinaryTransformOp transform_op) {
+
+  auto size = sycl::helpers::distance(first1, last1);
+  if (size <= 0)
+    return init;
+
+  auto q = snp.get_queue();
+
+  auto device = q.get_device();
+  using value_type_1 = typename std::iterator_traits<InputIt1>::value_type;
+  using value_type_2 = typename std::iterator_traits<InputIt2>::value_type;
+
+  auto d = compute_mapreduce_descriptor(
+      device, size, sizeof(value_type_1) + sizeof(value_type_2));
+
+  auto map = [=](size_t pos, value_type_1 x, value_type_2 y) {
+    return transform_op(x, y);
+  };
+
+  return buffer_map2reduce(snp, q, first1, first2, init, d, map, reduce_op);
+}
+
+/*
+ * Asynchronous transform_reduce, the result stays on the device until get()
+ * is called on the returned handle. If ``result`` is given, the value is
+ * written there.
+ */
+template <typename ExecutionPolicy, typename InputIt, typename UnaryOperation,
+          typename T, typename BinaryOperation>
+sycl::helpers::device_future<T> transform_reduce_async(
+    ExecutionPolicy& snp, InputIt b, InputIt e, UnaryOperation unary_op,
+    T init, BinaryOperation binary_op,
+    T *result = nullptr) {
+
+  auto size = sycl::helpers::distance(b, e);
+
+  auto q = snp.get_queue();
+
+  auto device = q.get_device();
+  using value_type = typename std::iterator_traits<InputIt>::value_type;
+
+  auto d = compute_mapreduce_descriptor(device, size, sizeof(value_type));
+
+  auto map = [=](size_t pos, value_type x) { return unary_op(x); };
+
+  return buffer_mapreduce_async(snp, q, b, init, d, map, binary_op, result);
+}
+
+/*
+ * transform_reduce_async writing into a device_pointer
+ */
+template <typename ExecutionPolicy, typename InputIt, typename UnaryOperation,
+          typename T, typename BinaryOperation>
+sycl::helpers::device_future<T> transform_reduce_async(
+    ExecutionPolicy& snp, InputIt b, InputIt e, UnaryOperation unary_op,
+    T init, BinaryOperation binary_op,
+    sycl::helpers::device_pointer<T> result) {
+  return transform_reduce_async(snp, b, e, unary_op, init, binary_op,
+                                result.get());
+}
+
 #endif
 
 }  // namespace impl
@@ -0,0 +1,96 @@
+/* Copyright (c) 2015-2018 The Khronos Group Inc.
+
+  Permission is hereby granted, free of charge, to any person obtaining a
+  copy of this software and/or associated documentation files (the
+  "Materials"), to deal in the Materials without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Materials, and to
+  permit persons to whom the Materials are furnished to do so, subject to
+  the following conditions:
+
+  The above copyright notice and this permission notice shall be included
+  in all copies or substantial portions of the Materials.
+
+  MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+  KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+  SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+     https://www.khronos.org/registry/
+
+  THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+*/
+
+#ifndef __SYCL_ASYNC_EXECUTION_POLICY__
+#define __SYCL_ASYNC_EXECUTION_POLICY__
+
+#include <memory>
+#include <vector>
+
+#include <CL/sycl.hpp>
+#include <sycl/execution_policy>
+
+namespace sycl {
+
+/** class sycl_async_execution_policy.
+* @brief Runs the algorithms on an in-order queue without waiting for them.
+* Algorithms which only write to device memory, such as transform, fill or
+* for_each, enqueue their kernels and return immediately; the queue runs them
+* in submission order, so a chain of algorithms needs no host round trip.
+* Algorithms returning a value computed on the device, such as reduce or
+* count, still wait for it; the *_async reductions return a device_future
+* instead.
+* Copies of the policy share the same queue and completion event.
+*/
+template <class KernelName = DefaultKernelName>
+class sycl_async_execution_policy : public sycl_execution_policy<KernelName> {
+ public:
+  /* Constructs the policy on an in-order queue with the context and device
+   * of ``q``, or on ``q`` itself if it is in-order already.
+   */
+  sycl_async_execution_policy(cl::sycl::queue q)
+      : sycl_execution_policy<KernelName>(
+            q.is_in_order()
+                ? q
+                : cl::sycl::queue(q.get_context(), q.get_device(),
+                                  cl::sycl::property::queue::in_order())) {
+    this->m_last_event = std::make_shared<cl::sycl::event>();
+  }
+
+  sycl_async_execution_policy(const sycl_async_execution_policy&) = default;
+
+  /* depends_on.
+  * @brief The algorithms run after this call wait for ``events``, e.g.
+  * commands submitted by the application to other queues.
+  */
+  void depends_on(const std::vector<cl::sycl::event>& events) {
+    this->complete(this->get_queue().submit([&](cl::sycl::handler& h) {
+      h.depends_on(events);
+      h.single_task([]() {});
+    }));
+  }
+
+  void depends_on(cl::sycl::event e) {
+    depends_on(std::vector<cl::sycl::event>{e});
+  }
+
+  /* get_event.
+  * @brief Completion event of the last algorithm enqueued through the policy,
+  * which in-order execution makes the completion of all of them.
+  */
+  cl::sycl::event get_event() const { return *this->m_last_event; }
+
+  /* wait.
+  * @brief Blocks until all the algorithms enqueued through the policy are
+  * done, and rethrows their asynchronous errors.
+  */
+  void wait() { this->get_queue().wait_and_throw(); }
+};
+
+}  // sycl
+
+#endif  // __SYCL_ASYNC_EXECUTION_POLICY__
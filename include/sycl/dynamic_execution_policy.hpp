@@ -0,0 +1,303 @@
+/* Copyright (c) 2015-2018 The Khronos Group Inc.
+
+  Permission is hereby granted, free of charge, to any person obtaining a
+  copy of this software and/or associated documentation files (the
+  "Materials"), to deal in the Materials without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Materials, and to
+  permit persons to whom the Materials are furnished to do so, subject to
+  the following conditions:
+
+  The above copyright notice and this permission notice shall be included
+  in all copies or substantial portions of the Materials.
+
+  MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+  KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+  SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+     https://www.khronos.org/registry/
+
+  THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+*/
+
+#ifndef __SYCL_DYNAMIC_EXECUTION_POLICY__
+#define __SYCL_DYNAMIC_EXECUTION_POLICY__
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include <CL/sycl.hpp>
+#include <sycl/execution_policy>
+#include <sycl/heterogeneous_execution_policy.hpp>
+#include <sycl/helpers/sycl_queue_worker.hpp>
+
+namespace sycl {
+
+namespace impl {
+
+/*
+ * Smallest chunk claimed by a queue of sycl_dynamic_execution_policy, so the
+ * launch of each chunk stays small next to its work
+ */
+constexpr size_t dynamic_min_chunk = 1 << 16;
+
+}  // namespace impl
+
+/** class sycl_dynamic_execution_policy.
+* @brief Distributes the workload across several SYCL queues without a fixed
+* ratio. The range is divided into chunks, and every queue, driven by its own
+* host thread, claims the next chunk from a shared atomic cursor as soon as it
+* is done with the previous one, so faster devices take more chunks and all
+* of them finish at about the same time.
+* As for sycl_heterogeneous_execution_policy, the iterators must be USM
+* accessible from every queue. Reductions combine the partial results of the
+* queues in no particular order, so their operation must be commutative.
+*/
+template <class KernelName>
+class sycl_dynamic_execution_policy : public sycl_execution_policy<KernelName> {
+  using policy_type = sycl_execution_policy<KernelName>;
+
+  std::vector<cl::sycl::queue> m_queues;
+  size_t m_chunks_per_queue;
+
+  /* Runs f(queue_index, policy, begin, end) on chunks of [0, n) claimed by
+  * every queue, each driven by the worker thread of the queue, in turn until
+  * none is left, and waits for all of them.
+  */
+  template <class F>
+  void schedule(size_t n, F f) {
+    if (n == 0)
+      return;
+    const size_t chunk = std::max(
+        impl::dynamic_min_chunk,
+        impl::up_rounded_division(n, m_queues.size() * m_chunks_per_queue));
+    // a single chunk would leave the other queues with nothing to claim
+    if (chunk >= n) {
+      policy_type p(m_queues[0]);
+      f(size_t{0}, p, size_t{0}, n);
+      return;
+    }
+    std::atomic<size_t> cursor{0};
+    auto worker = [&](size_t queue_index) {
+      policy_type p(m_queues[queue_index]);
+      for (size_t begin = cursor.fetch_add(chunk); begin < n;
+           begin = cursor.fetch_add(chunk)) {
+        f(queue_index, p, begin, std::min(begin + chunk, n));
+      }
+    };
+    std::vector<std::future<void>> others;
+    for (size_t i = 1; i < m_queues.size(); i++) {
+      others.push_back(sycl::helpers::queue_worker::of(m_queues[i]).run(
+          [&worker, i] { worker(i); }));
+    }
+    sycl::helpers::run_and_join(others, [&] { worker(0); });
+  }
+
+  /* Reduction of [0, n) and init with ``op``. ``chunk_reduce(p, begin, end,
+  * acc)`` reduces [begin, end) after ``acc``, which is the partial result of
+  * the queue. The first chunk of a queue has no partial result yet, so it
+  * reduces [begin + 1, end) after ``chunk_head(p, begin)``.
+  */
+  template <class T, class ChunkHead, class ChunkReduce, class BinaryOperation>
+  T schedule_reduce(size_t n, T init, ChunkHead chunk_head,
+                    ChunkReduce chunk_reduce, BinaryOperation op) {
+    std::vector<std::optional<T>> partials(m_queues.size());
+    schedule(n, [&](size_t queue_index, policy_type &p, size_t begin,
+                    size_t end) {
+      auto &partial = partials[queue_index];
+      if (partial) {
+        partial = chunk_reduce(p, begin, end, *partial);
+      } else {
+        partial = chunk_reduce(p, begin + 1, end, chunk_head(p, begin));
+      }
+    });
+    for (auto &partial : partials) {
+      if (partial) {
+        init = op(init, *partial);
+      }
+    }
+    return init;
+  }
+
+ public:
+  /* Constructs the policy over ``queues``, the first of which is the queue
+  * of the policy. Each queue takes about ``chunks_per_queue`` chunks when
+  * the devices are equally fast.
+  */
+  sycl_dynamic_execution_policy(std::vector<cl::sycl::queue> queues,
+                                size_t chunks_per_queue = 8)
+      : sycl_execution_policy<KernelName>(queues.at(0)),
+        m_queues(queues),
+        m_chunks_per_queue(std::max<size_t>(chunks_per_queue, 1)) {}
+
+  /** reduce
+   * @brief Reduction of the range [first, last) with a default addition
+   */
+  template <class InputIterator>
+  typename std::iterator_traits<InputIterator>::value_type reduce(
+      InputIterator first, InputIterator last) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return reduce(first, last, type_(0),
+                  [=](type_ v1, type_ v2) { return v1 + v2; });
+  }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) and init with a default
+   * addition
+   */
+  template <class InputIterator, class T>
+  T reduce(InputIterator first, InputIterator last, T init) {
+    return reduce(first, last, init, [=](T v1, T v2) { return v1 + v2; });
+  }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) and init with binop
+   */
+  template <class InputIterator, class T, class BinaryOperation>
+  T reduce(InputIterator first, InputIterator last, T init,
+           BinaryOperation binop) {
+    return schedule_reduce(
+        std::distance(first, last), init,
+        [&](policy_type &p, size_t begin) -> T {
+          return impl::read_element(p, first + begin);
+        },
+        [&](policy_type &p, size_t begin, size_t end, T acc) {
+          return impl::reduce(p, first + begin, first + end, acc, binop);
+        },
+        binop);
+  }
+
+  /* transform.
+  * @brief Applies an Unary Operator across the range [b, e).
+  */
+  template <class Iterator, class OutputIterator, class UnaryOperation>
+  OutputIterator transform(Iterator b, Iterator e, OutputIterator out_b,
+                           UnaryOperation op) {
+    const size_t n = std::distance(b, e);
+    schedule(n, [&](size_t, policy_type &p, size_t begin, size_t end) {
+      impl::transform(p, b + begin, b + end, out_b + begin, op);
+    });
+    return out_b + n;
+  }
+
+  /* transform.
+  * @brief Applies a Binary Operator across the range [first1, last1).
+  */
+  template <class InputIt1, class InputIt2, class OutputIt,
+            class BinaryOperation>
+  OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                     OutputIt result, BinaryOperation binary_op) {
+    const size_t n = std::distance(first1, last1);
+    schedule(n, [&](size_t, policy_type &p, size_t begin, size_t end) {
+      impl::transform(p, first1 + begin, first1 + end, first2 + begin,
+                      result + begin, binary_op);
+    });
+    return result + n;
+  }
+
+  /* for_each
+   */
+  template <class Iterator, class UnaryFunction>
+  void for_each(Iterator b, Iterator e, UnaryFunction f) {
+    schedule(std::distance(b, e),
+             [&](size_t, policy_type &p, size_t begin, size_t end) {
+      impl::for_each(p, b + begin, b + end, f);
+    });
+  }
+
+  /* fill.
+  * @brief Assigns value to every element of the range [first, last)
+  */
+  template <class ForwardIt, class T>
+  void fill(ForwardIt first, ForwardIt last, const T &value) {
+    schedule(std::distance(first, last),
+             [&](size_t, policy_type &p, size_t begin, size_t end) {
+      impl::fill(p, first + begin, first + end, value);
+    });
+  }
+
+  /* transform_reduce.
+  * @brief Reduction with binary_op of init and of unary_op applied to the
+  * elements of the range [first, last)
+  */
+  template <class InputIterator, class UnaryOperation, class T,
+            class BinaryOperation>
+  T transform_reduce(InputIterator first, InputIterator last,
+                     UnaryOperation unary_op, T init,
+                     BinaryOperation binary_op) {
+    return schedule_reduce(
+        std::distance(first, last), init,
+        [&](policy_type &p, size_t begin) -> T {
+          return unary_op(impl::read_element(p, first + begin));
+        },
+        [&](policy_type &p, size_t begin, size_t end, T acc) {
+          return impl::transform_reduce(p, first + begin, first + end,
+                                        unary_op, acc, binary_op);
+        },
+        binary_op);
+  }
+
+  /* transform_reduce.
+  * @brief Reduction with binary_op of init and of transform_op applied to
+  * the pairs of elements of the ranges [first1, last1) and first2..
+  */
+  template <class InputIt1, class InputIt2, class T, class BinaryOperation1,
+            class BinaryOperation2>
+  T transform_reduce(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init,
+                     BinaryOperation1 binary_op, BinaryOperation2 transform_op) {
+    return schedule_reduce(
+        std::distance(first1, last1), init,
+        [&](policy_type &p, size_t begin) -> T {
+          return transform_op(impl::read_element(p, first1 + begin),
+                              impl::read_element(p, first2 + begin));
+        },
+        [&](policy_type &p, size_t begin, size_t end, T acc) {
+          return impl::transform_reduce(p, first1 + begin, first1 + end,
+                                        first2 + begin, acc, binary_op,
+                                        transform_op);
+        },
+        binary_op);
+  }
+
+  /* count.
+   * @brief Returns the number of elements in the range ``[first, last)``
+   * that are equal to ``value``.
+   */
+  template <class InputIt, class T>
+  typename std::iterator_traits<InputIt>::difference_type count(
+      InputIt first, InputIt last, T value) {
+    return count_if(first, last, [=](T other) { return value == other; });
+  }
+
+  /* count_if.
+  * @brief Returns the number of elements in the range ``[first, last)`` for
+  * which p is true.
+  */
+  template <class InputIt, class UnaryPredicate>
+  typename std::iterator_traits<InputIt>::difference_type count_if(
+      InputIt first, InputIt last, UnaryPredicate p) {
+    using difference_type =
+        typename std::iterator_traits<InputIt>::difference_type;
+    std::vector<difference_type> counts(m_queues.size(), 0);
+    schedule(std::distance(first, last),
+             [&](size_t queue_index, policy_type &pol, size_t begin,
+                 size_t end) {
+      counts[queue_index] += impl::count_if(pol, first + begin, first + end, p);
+    });
+    return std::accumulate(counts.begin(), counts.end(), difference_type{0});
+  }
+};
+
+}  // sycl
+
+#endif  // __SYCL_DYNAMIC_EXECUTION_POLICY__
@@ -41,9 +41,13 @@
 #ifndef __EXPERIMENTAL_DETAIL_SYCL_BUFFERS__
 #define __EXPERIMENTAL_DETAIL_SYCL_BUFFERS__
 
+#include <algorithm>
+#include <iterator>
 #include <type_traits>
 #include <typeinfo>
 #include <memory>
+#include <new>
+#include <vector>
 
 /** @defgroup sycl_helpers
  *
@@ -225,13 +229,37 @@ cl::sycl::buffer<ElemT, 1>& make_temp_buffer(size_t size) {
   return buf;
 }
 
+/**
+ * @brief Temporary allocation of a thread for one Order, on one device
+ */
+struct temp_pointer_slot {
+  cl::sycl::context context;
+  cl::sycl::device device;
+  size_t current_size;
+  void* ptr;
+};
+
 /**
  * @brief Constructs a read/write sycl pointer given a size and an allocation function
+ * Each thread keeps one allocation per Order and per context and device, as
+ * a thread may drive queues of several devices, e.g. for the policies
+ * running several queues at once.
  */
 template <typename AllocFunc, int Order = 0>
 void* make_temp_pointer_impl(size_t alignment, size_t size, cl::sycl::queue& queue, AllocFunc alloc_func) {
-  thread_local size_t current_size = 0;
-  thread_local void* ptr = nullptr;
+  thread_local std::vector<temp_pointer_slot> slots;
+  const cl::sycl::context context = queue.get_context();
+  const cl::sycl::device device = queue.get_device();
+  auto slot = std::find_if(slots.begin(), slots.end(),
+                           [&](const temp_pointer_slot& s) {
+                             return s.context == context && s.device == device;
+                           });
+  if (slot == slots.end()) {
+    slots.push_back(temp_pointer_slot{context, device, 0, nullptr});
+    slot = std::prev(slots.end());
+  }
+  size_t& current_size = slot->current_size;
+  void*& ptr = slot->ptr;
 
   if (size > current_size || ptr == nullptr) {
     void* old_ptr = ptr;
@@ -240,11 +268,16 @@ void* make_temp_pointer_impl(size_t alignment, size_t size, cl::sycl::queue& que
       new_size = (new_size / alignment + 1) * alignment;
     }
     void* new_ptr = alloc_func(alignment, new_size, queue);
-    assert(new_ptr != nullptr);
+    if (new_ptr == nullptr) {
+      // the slot keeps its previous allocation
+      throw std::bad_alloc();
+    }
     //queue.memcpy(new_ptr, ptr, current_size).wait();
     current_size = new_size;
     ptr = new_ptr;
     if (old_ptr != nullptr) {
+        // commands of asynchronous policies may still use it
+        queue.wait();
         cl::sycl::free(old_ptr, queue);
     }
   }
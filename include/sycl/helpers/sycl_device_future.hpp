@@ -0,0 +1,68 @@
+#ifndef __EXPERIMENTAL_DETAIL_SYCL_DEVICE_FUTURE__
+#define __EXPERIMENTAL_DETAIL_SYCL_DEVICE_FUTURE__
+
+#include <memory>
+#include <vector>
+
+#include <sycl/helpers/sycl_buffers.hpp>
+
+namespace sycl {
+namespace helpers {
+
+// forward declaration, as sycl_device_pointer.hpp needs the execution policy
+template <typename T>
+class device_pointer;
+
+/**
+ * @brief Handle on a value being computed on the device.
+ * It holds the event of the computation, the device location of the value
+ * and the temporary memory used by the computation, released once it is
+ * done. The value stays on the device until `get()` is called, so later
+ * kernels can consume it through `device_data()` without a host round trip.
+ * As for the futures returned by `std::async`, destroying the last copy of a
+ * handle waits for the computation.
+ */
+template <typename T>
+class device_future {
+ private:
+  struct state {
+    cl::sycl::queue queue;
+    cl::sycl::event event;
+    T *ptr;
+    std::vector<void *> owned;
+
+    ~state() {
+      event.wait();
+      for (void *p : owned) {
+        cl::sycl::free(p, queue);
+      }
+    }
+  };
+
+  std::shared_ptr<state> _state;
+
+ public:
+  device_future(cl::sycl::queue queue, cl::sycl::event event, T *ptr,
+                std::vector<void *> owned = {})
+      : _state(new state{queue, event, ptr, std::move(owned)}) {}
+
+  /** @brief Blocks until the value is available on the device. */
+  void wait() const { _state->event.wait(); }
+
+  /** @brief Waits for the value and copies it back to the host. */
+  T get() const {
+    wait();
+    return read_device_pointer(_state->ptr, _state->queue);
+  }
+
+  /** @brief Event to depend on before reading `device_data()`. */
+  cl::sycl::event get_event() const { return _state->event; }
+
+  /** @brief Device location of the value. */
+  device_pointer<T> device_data() const { return device_pointer<T>(_state->ptr); }
+};
+
+}  // namespace helpers
+}  // namespace sycl
+
+#endif  // __EXPERIMENTAL_DETAIL_SYCL_DEVICE_FUTURE__
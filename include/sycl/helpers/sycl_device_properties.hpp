@@ -0,0 +1,65 @@
+#ifndef __EXPERIMENTAL_DETAIL_SYCL_DEVICE_PROPERTIES__
+#define __EXPERIMENTAL_DETAIL_SYCL_DEVICE_PROPERTIES__
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <utility>
+
+#include <CL/sycl.hpp>
+
+namespace sycl {
+namespace helpers {
+
+/**
+ * @brief Device properties used to size the kernels of the algorithms.
+ */
+struct device_properties {
+  size_t max_compute_units;
+  /** Maximum number of work items in a 1D work group. */
+  size_t max_work_item;
+  size_t local_mem_size;
+  /** Name of the device, in the keys of the tuning cache. */
+  std::string name;
+};
+
+/**
+ * @brief Returns the properties of ``device``.
+ * Runtime queries are not free and the algorithms need these values on every
+ * call, so they are queried once per device and kept in a thread local cache,
+ * as the temporary device memory is. A program only sees a handful of
+ * devices, so the cache is a plain deque searched linearly, which keeps the
+ * returned references valid.
+ */
+inline const device_properties &get_device_properties(
+    const cl::sycl::device &device) {
+  thread_local std::deque<std::pair<cl::sycl::device, device_properties>> cache;
+  for (const auto &entry : cache) {
+    if (entry.first == device) {
+      return entry.second;
+    }
+  }
+
+  const cl::sycl::id<3> max_work_item_sizes =
+    device.get_info<
+#if defined(__COMPUTECPP__)
+      cl::sycl::info::device::max_work_item_sizes
+#else
+      cl::sycl::info::device::max_work_item_sizes<3>
+#endif
+    >();
+  const device_properties properties {
+    device.get_info<cl::sycl::info::device::max_compute_units>(),
+    std::min(device.get_info<cl::sycl::info::device::max_work_group_size>(),
+             max_work_item_sizes[0]),
+    device.get_info<cl::sycl::info::device::local_mem_size>(),
+    device.get_info<cl::sycl::info::device::name>()
+  };
+  cache.emplace_back(device, properties);
+  return cache.back().second;
+}
+
+}  // namespace helpers
+}  // namespace sycl
+
+#endif  // __EXPERIMENTAL_DETAIL_SYCL_DEVICE_PROPERTIES__
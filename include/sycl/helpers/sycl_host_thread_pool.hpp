@@ -0,0 +1,205 @@
+#ifndef __EXPERIMENTAL_DETAIL_SYCL_HOST_THREAD_POOL__
+#define __EXPERIMENTAL_DETAIL_SYCL_HOST_THREAD_POOL__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sycl {
+namespace helpers {
+
+/**
+ * @brief Pool of host threads running fork-join loops with work stealing.
+ *
+ * Every worker owns a deque of tasks. ``parallel_for`` splits its range in
+ * halves, pushing one half to the back of the deque of the calling thread
+ * and going on with the other, until single items are left. A thread pops
+ * the most recent task of its own deque, which is the nearest in memory to
+ * what it just ran, and when its deque is empty it steals the oldest task of
+ * another deque, which is the largest half left there. Threads outside the
+ * pool share one more deque, and help run tasks until their loop is done.
+ */
+class host_thread_pool {
+ public:
+  explicit host_thread_pool(
+      size_t nb_thread = std::max(1u, std::thread::hardware_concurrency()))
+      : m_deques(std::max<size_t>(nb_thread, 1)) {
+    for (auto &deque : m_deques) {
+      deque = std::make_unique<task_deque>();
+    }
+    // the callers use the first deque, and run tasks along the workers
+    for (size_t i = 1; i < m_deques.size(); i++) {
+      m_threads.emplace_back([this, i] { work(i); });
+    }
+  }
+
+  host_thread_pool(const host_thread_pool &) = delete;
+  host_thread_pool &operator=(const host_thread_pool &) = delete;
+
+  ~host_thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(m_sleep_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto &thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  // Number of threads running the loops, counting the caller
+  size_t size() const { return m_deques.size(); }
+
+  /**
+   * @brief Calls ``f(i)`` for every i in [0, count) on the threads of the
+   * pool and waits for all of them. The first exception thrown by ``f`` is
+   * rethrown once every call is done.
+   */
+  template <class F>
+  void parallel_for(size_t count, F f) {
+    if (count == 0) {
+      return;
+    }
+    if (count == 1 || size() == 1) {
+      for (size_t i = 0; i < count; i++) {
+        f(i);
+      }
+      return;
+    }
+
+    std::atomic<size_t> remaining{count};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    std::function<void(size_t, size_t)> run = [&](size_t begin, size_t end) {
+      while (end - begin > 1) {
+        const size_t middle = begin + (end - begin) / 2;
+        push([&run, middle, end] { run(middle, end); });
+        end = middle;
+      }
+      try {
+        f(begin);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+      remaining.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    run(0, count);
+    while (remaining.load(std::memory_order_acquire) != 0) {
+      if (!run_one(own_deque())) {
+        std::this_thread::yield();
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  /**
+   * @brief Pool shared by the host policies, with a thread per hardware
+   * thread
+   */
+  static host_thread_pool &default_pool() {
+    static host_thread_pool pool;
+    return pool;
+  }
+
+ private:
+  struct task_deque {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  std::vector<std::unique_ptr<task_deque>> m_deques;
+  std::vector<std::thread> m_threads;
+  std::atomic<size_t> m_pending{0};
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_wake;
+  bool m_stop = false;
+
+  // Pool and deque of the current thread, if it is a worker
+  static const host_thread_pool *&current_pool() {
+    thread_local const host_thread_pool *pool = nullptr;
+    return pool;
+  }
+
+  static size_t &current_deque() {
+    thread_local size_t deque = 0;
+    return deque;
+  }
+
+  size_t own_deque() const {
+    return (current_pool() == this) ? current_deque() : 0;
+  }
+
+  void push(std::function<void()> task) {
+    auto &deque = *m_deques[own_deque()];
+    {
+      std::lock_guard<std::mutex> lock(deque.mutex);
+      deque.tasks.push_back(std::move(task));
+    }
+    m_pending.fetch_add(1, std::memory_order_release);
+    // taking the lock orders the wake up after the check of a sleeping worker
+    { std::lock_guard<std::mutex> lock(m_sleep_mutex); }
+    m_wake.notify_one();
+  }
+
+  // Runs the newest task of deque ``self``, or steals the oldest of another
+  bool run_one(size_t self) {
+    std::function<void()> task;
+    {
+      auto &deque = *m_deques[self];
+      std::lock_guard<std::mutex> lock(deque.mutex);
+      if (!deque.tasks.empty()) {
+        task = std::move(deque.tasks.back());
+        deque.tasks.pop_back();
+      }
+    }
+    for (size_t i = 1; !task && i < m_deques.size(); i++) {
+      auto &deque = *m_deques[(self + i) % m_deques.size()];
+      std::lock_guard<std::mutex> lock(deque.mutex);
+      if (!deque.tasks.empty()) {
+        task = std::move(deque.tasks.front());
+        deque.tasks.pop_front();
+      }
+    }
+    if (!task) {
+      return false;
+    }
+    m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+  }
+
+  void work(size_t self) {
+    current_pool() = this;
+    current_deque() = self;
+    while (true) {
+      if (run_one(self)) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(m_sleep_mutex);
+      m_wake.wait(lock, [this] {
+        return m_stop || m_pending.load(std::memory_order_acquire) != 0;
+      });
+      if (m_stop) {
+        return;
+      }
+    }
+  }
+};
+
+}  // namespace helpers
+}  // namespace sycl
+
+#endif  // __EXPERIMENTAL_DETAIL_SYCL_HOST_THREAD_POOL__
@@ -0,0 +1,229 @@
+#ifndef __EXPERIMENTAL_DETAIL_SYCL_HOST_THRESHOLDS__
+#define __EXPERIMENTAL_DETAIL_SYCL_HOST_THRESHOLDS__
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <CL/sycl.hpp>
+
+namespace sycl {
+namespace helpers {
+
+/**
+ * @brief Number of elements below which the algorithms of
+ * sycl_execution_policy run on the host instead of submitting kernels, whose
+ * fixed cost dominates on small inputs.
+ *
+ * The host path is opt-in. Each algorithm may be given its own threshold with
+ * ``set_threshold``. The others use the default threshold, which is 0, i.e.
+ * no host path, unless ``set_default_threshold`` or the
+ * ``SYCL_PSTL_HOST_THRESHOLD`` environment variable fix it for every device.
+ * ``calibrate_default_threshold``, or ``SYCL_PSTL_HOST_THRESHOLD=auto``,
+ * calibrates it for each kind of algorithm on the first use of each device
+ * instead: element-wise algorithms, reductions, scans and sorts. It is then
+ * the number of elements the host processes with a representative algorithm
+ * of the kind in the time of the kernel round trips the device needs: one
+ * for element-wise algorithms and reductions, two for scans, and one per
+ * merge level for sorts.
+ */
+class host_thresholds {
+ public:
+  // Upper bound of the calibrated thresholds
+  static constexpr size_t max_calibrated = size_t{1} << 20;
+
+  static host_thresholds &instance() {
+    static host_thresholds thresholds;
+    return thresholds;
+  }
+
+  void set_threshold(const std::string &algorithm, size_t n) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _thresholds[algorithm] = n;
+  }
+
+  void set_default_threshold(size_t n) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_default_from_environment) {
+      _default = n;
+    }
+  }
+
+  void calibrate_default_threshold() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_default_from_environment) {
+      _default.reset();
+    }
+  }
+
+  size_t get_threshold(const std::string &algorithm,
+                       const cl::sycl::queue &q) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _thresholds.find(algorithm);
+    if (it != _thresholds.end()) {
+      return it->second;
+    }
+    if (_default) {
+      return *_default;
+    }
+    const cl::sycl::device device = q.get_device();
+    auto entry = std::find_if(
+        _calibrated.begin(), _calibrated.end(),
+        [&](const calibration &c) { return c.device == device; });
+    if (entry == _calibrated.end()) {
+      _calibrated.push_back(calibration{device, launch_time(q), {}});
+      entry = std::prev(_calibrated.end());
+    }
+    const size_t k = static_cast<size_t>(kind_of(algorithm));
+    if (!entry->thresholds[k]) {
+      entry->thresholds[k] = threshold(static_cast<kind>(k), entry->launch);
+    }
+    return *entry->thresholds[k];
+  }
+
+ private:
+  std::mutex _mutex;
+  std::map<std::string, size_t> _thresholds;
+  // calibrated per device when empty
+  std::optional<size_t> _default = 0;
+  bool _default_from_environment = false;
+
+  // Kinds of algorithms calibrated separately
+  enum class kind { element_wise, reduction, scan, sort, count };
+
+  struct calibration {
+    cl::sycl::device device;
+    // time of an empty kernel round trip, in seconds
+    double launch;
+    std::array<std::optional<size_t>, static_cast<size_t>(kind::count)>
+        thresholds;
+  };
+  std::vector<calibration> _calibrated;
+
+  host_thresholds() {
+    if (const char *env = std::getenv("SYCL_PSTL_HOST_THRESHOLD")) {
+      if (std::string(env) == "auto") {
+        _default.reset();
+      } else {
+        _default = std::strtoull(env, nullptr, 10);
+      }
+      _default_from_environment = true;
+    }
+  }
+
+  static kind kind_of(const std::string &algorithm) {
+    if (algorithm == "sort") {
+      return kind::sort;
+    }
+    // the compactions are scans of the kept elements
+    if (algorithm.find("scan") != std::string::npos ||
+        algorithm.compare(0, 6, "remove") == 0 || algorithm == "copy_if") {
+      return kind::scan;
+    }
+    if (algorithm == "transform" || algorithm.compare(0, 8, "for_each") == 0 ||
+        algorithm == "fill" || algorithm == "generate" ||
+        algorithm.compare(0, 7, "replace") == 0 ||
+        algorithm.compare(0, 7, "reverse") == 0 ||
+        algorithm.compare(0, 6, "rotate") == 0) {
+      return kind::element_wise;
+    }
+    return kind::reduction;
+  }
+
+  static double launch_time(cl::sycl::queue q) {
+    using clock = std::chrono::steady_clock;
+    // the first round trips include the warm up of the device
+    double launch = std::numeric_limits<double>::max();
+    for (int i = 0; i < 5; i++) {
+      const auto start = clock::now();
+      q.submit([&](cl::sycl::handler &h) { h.single_task([]() {}); }).wait();
+      const std::chrono::duration<double> time = clock::now() - start;
+      launch = std::min(launch, time.count());
+    }
+    return launch;
+  }
+
+  /* Time taken by the host per element of an algorithm of kind ``k``, and
+  * per merge level for sorts
+  */
+  static double host_element_time(kind k) {
+    using clock = std::chrono::steady_clock;
+    const size_t size = 1 << 16;
+    std::vector<float> v(size), out(size);
+    for (size_t i = 0; i < size; i++) {
+      v[i] = static_cast<float>((i * 7919) % size);
+    }
+    const auto start = clock::now();
+    switch (k) {
+      case kind::element_wise:
+        std::transform(v.begin(), v.end(), out.begin(),
+                       [](float x) { return 2 * x + 1; });
+        break;
+      case kind::scan:
+        std::inclusive_scan(v.begin(), v.end(), out.begin());
+        break;
+      case kind::sort:
+        std::sort(v.begin(), v.end());
+        break;
+      default: {
+        volatile float sink = std::accumulate(v.begin(), v.end(), 0.0f);
+        (void)sink;
+      }
+    }
+    const std::chrono::duration<double> time = clock::now() - start;
+    volatile float sink = out[size / 2] + v[size / 3];
+    (void)sink;
+    // a sort of size elements does log2(size) = 16 merge levels
+    return time.count() / ((k == kind::sort) ? size * 16.0 : size);
+  }
+
+  /* Threshold of the algorithms of kind ``k`` on a device with a kernel
+  * round trip of ``launch`` seconds. A sort of n elements costs about
+  * log2(n) round trips on the device and log2(n) passes over the elements on
+  * the host, so the logarithms cancel out.
+  */
+  static size_t threshold(kind k, double launch) {
+    const double element = host_element_time(k);
+    if (element <= 0) {
+      return max_calibrated;
+    }
+    const double round_trips = (k == kind::scan) ? 2 : 1;
+    const double elements = round_trips * launch / element;
+    return static_cast<size_t>(
+        std::min(elements, static_cast<double>(max_calibrated)));
+  }
+};
+
+/**
+ * @brief Whether the host can access the element at ``it``: the iterator
+ * refers to memory, which is not a device USM allocation of the context of
+ * ``q``.
+ */
+template <class Iterator>
+bool is_host_accessible(const cl::sycl::queue &q, Iterator it) {
+  using reference = typename std::iterator_traits<Iterator>::reference;
+  if constexpr (std::is_lvalue_reference<reference>::value) {
+    const void *ptr = std::addressof(*it);
+    return cl::sycl::get_pointer_type(ptr, q.get_context()) !=
+           cl::sycl::usm::alloc::device;
+  } else {
+    return false;
+  }
+}
+
+}  // namespace helpers
+}  // namespace sycl
+
+#endif  // __EXPERIMENTAL_DETAIL_SYCL_HOST_THRESHOLDS__
@@ -0,0 +1,143 @@
+#ifndef __EXPERIMENTAL_DETAIL_SYCL_QUEUE_WORKER__
+#define __EXPERIMENTAL_DETAIL_SYCL_QUEUE_WORKER__
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <CL/sycl.hpp>
+
+namespace sycl {
+namespace helpers {
+
+/**
+ * @brief Host thread driving one queue for the policies which run several
+ * queues at once.
+ *
+ * The algorithms keep their temporary device memory and the device
+ * properties in thread local caches, so a thread started per call would
+ * allocate them again every time and never free them. Each queue is rather
+ * given one worker, started on its first use and kept until the program
+ * exits, which runs the tasks of every policy using the queue in turn and
+ * reuses the caches of that queue.
+ */
+class queue_worker {
+ public:
+  /**
+   * @brief Worker of ``q``, shared by every policy using the queue or a copy
+   * of it
+   */
+  static queue_worker &of(const cl::sycl::queue &q) {
+    static std::mutex mutex;
+    static std::vector<std::pair<cl::sycl::queue, std::unique_ptr<queue_worker>>>
+        workers;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &worker : workers) {
+      if (worker.first == q) {
+        return *worker.second;
+      }
+    }
+    workers.emplace_back(q, std::make_unique<queue_worker>());
+    return *workers.back().second;
+  }
+
+  queue_worker() : m_thread([this] { work(); }) {}
+
+  queue_worker(const queue_worker &) = delete;
+  queue_worker &operator=(const queue_worker &) = delete;
+
+  ~queue_worker() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+  }
+
+  /**
+   * @brief Runs ``f()`` on the worker, after the tasks given before it. The
+   * future rethrows the exception thrown by ``f``. A task given by the worker
+   * itself runs at once, as waiting for it would never end.
+   */
+  template <class F>
+  std::future<void> run(F f) {
+    std::packaged_task<void()> task(std::move(f));
+    auto future = task.get_future();
+    if (std::this_thread::get_id() == m_thread.get_id()) {
+      task();
+      return future;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+    return future;
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::deque<std::packaged_task<void()>> m_tasks;
+  bool m_stop = false;
+  std::thread m_thread;
+
+  void work() {
+    while (true) {
+      std::packaged_task<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+        if (m_tasks.empty()) {
+          return;
+        }
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      task();
+    }
+  }
+};
+
+/**
+ * @brief Runs ``f()`` on the calling thread, then waits for every task of
+ * ``others``, even when ``f`` throws, since the tasks may reference what the
+ * caller is about to destroy. Rethrows the exception of ``f``, or else the
+ * first one of the tasks.
+ */
+template <class F>
+void run_and_join(std::vector<std::future<void>> &others, F f) {
+  std::exception_ptr error;
+  try {
+    f();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  for (auto &other : others) {
+    if (!other.valid()) {
+      continue;
+    }
+    try {
+      other.get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace helpers
+}  // namespace sycl
+
+#endif  // __EXPERIMENTAL_DETAIL_SYCL_QUEUE_WORKER__
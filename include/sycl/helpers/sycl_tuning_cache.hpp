@@ -0,0 +1,171 @@
+#ifndef __EXPERIMENTAL_DETAIL_SYCL_TUNING_CACHE__
+#define __EXPERIMENTAL_DETAIL_SYCL_TUNING_CACHE__
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <CL/sycl.hpp>
+
+namespace sycl {
+namespace helpers {
+
+/**
+ * @brief Launch geometry chosen by the autotuner.
+ */
+struct tuned_launch {
+  size_t nb_work_item;
+  size_t nb_work_group;
+};
+
+/**
+ * @brief Winners of the autotuner, keyed by algorithm, size of the
+ * accumulated type, device and size bucket, and persisted in a tuning file.
+ *
+ * Autotuning is opt-in: it is off until ``set_mode`` is called, and the
+ * ``SYCL_PSTL_TUNING`` environment variable, when set, overrides the mode:
+ *  - ``off``: use the default heuristics,
+ *  - ``on``: use the tuning file, benchmark the configurations it lacks,
+ *  - ``force``: benchmark again every configuration met in this run.
+ * The tuning file is ``SYCL_PSTL_TUNING_FILE`` if set, the path given to
+ * ``set_file`` otherwise, ``sycl_pstl_tuning.txt`` by default. It is loaded
+ * on first use and rewritten after every new winner, one tab separated
+ * entry per line.
+ */
+class tuning_cache {
+ public:
+  enum class mode { off, on, force };
+
+  static tuning_cache &instance() {
+    static tuning_cache cache;
+    return cache;
+  }
+
+  // read by every reduction, so without taking the lock
+  mode get_mode() const { return _mode.load(std::memory_order_relaxed); }
+
+  void set_mode(mode m) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_mode_from_environment) {
+      _mode = m;
+    }
+  }
+
+  void set_file(const std::string &path) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_file_from_environment) {
+      _path = path;
+      _loaded = false;
+    }
+  }
+
+  /**
+   * @brief Key of an entry, with the size rounded down to a power of two.
+   * ``device_name`` is the cached name of device_properties.
+   */
+  static std::string make_key(const std::string &algorithm, size_t sizeofB,
+                              const std::string &device_name, size_t size) {
+    size_t bucket = 0;
+    while ((size >> bucket) > 1) {
+      bucket++;
+    }
+    std::ostringstream key;
+    key << algorithm << '\t' << sizeofB << '\t' << device_name << '\t'
+        << bucket;
+    return key.str();
+  }
+
+  /**
+   * @brief Looks ``key`` up, always missing in ``force`` mode until the key
+   * has been tuned in this run.
+   */
+  bool find(const std::string &key, tuned_launch &launch) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    load();
+    if (get_mode() == mode::force && _tuned.count(key) == 0) {
+      return false;
+    }
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+      return false;
+    }
+    launch = it->second;
+    return true;
+  }
+
+  void store(const std::string &key, const tuned_launch &launch) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    load();
+    _entries[key] = launch;
+    _tuned.insert(key);
+    std::ofstream file(_path, std::ios::trunc);
+    for (const auto &entry : _entries) {
+      file << entry.first << '\t' << entry.second.nb_work_item << '\t'
+           << entry.second.nb_work_group << '\n';
+    }
+  }
+
+ private:
+  std::mutex _mutex;
+  std::atomic<mode> _mode{mode::off};
+  bool _mode_from_environment = false;
+  std::string _path = "sycl_pstl_tuning.txt";
+  bool _file_from_environment = false;
+  bool _loaded = false;
+  std::map<std::string, tuned_launch> _entries;
+  std::set<std::string> _tuned;
+
+  tuning_cache() {
+    if (const char *env = std::getenv("SYCL_PSTL_TUNING")) {
+      const std::string value = env;
+      _mode_from_environment = true;
+      if (value == "on" || value == "1") {
+        _mode = mode::on;
+      } else if (value == "force") {
+        _mode = mode::force;
+      } else {
+        _mode = mode::off;
+      }
+    }
+    if (const char *env = std::getenv("SYCL_PSTL_TUNING_FILE")) {
+      _path = env;
+      _file_from_environment = true;
+    }
+  }
+
+  // the last two fields of a line are the launch, the others the key
+  void load() {
+    if (_loaded) {
+      return;
+    }
+    _loaded = true;
+    std::ifstream file(_path);
+    std::string line;
+    while (std::getline(file, line)) {
+      const auto group_tab = line.rfind('\t');
+      if (group_tab == std::string::npos || group_tab == 0) {
+        continue;
+      }
+      const auto item_tab = line.rfind('\t', group_tab - 1);
+      if (item_tab == std::string::npos) {
+        continue;
+      }
+      tuned_launch launch;
+      std::istringstream values(line.substr(item_tab + 1));
+      if (values >> launch.nb_work_item >> launch.nb_work_group &&
+          launch.nb_work_item > 0 && launch.nb_work_group > 0) {
+        _entries.emplace(line.substr(0, item_tab), launch);
+      }
+    }
+  }
+};
+
+}  // namespace helpers
+}  // namespace sycl
+
+#endif  // __EXPERIMENTAL_DETAIL_SYCL_TUNING_CACHE__
@@ -28,27 +28,187 @@
 #ifndef __SYCL_HETEROGENEOUS_EXECUTION_POLICY__
 #define __SYCL_HETEROGENEOUS_EXECUTION_POLICY__
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdlib>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include <CL/sycl.hpp>
 #include <sycl/execution_policy>
+#include <sycl/algorithm/copy.hpp>
+#include <sycl/algorithm/sort.hpp>
 #include <sycl/algorithm/transform.hpp>
+#include <sycl/helpers/sycl_buffers.hpp>
+#include <sycl/helpers/sycl_queue_worker.hpp>
 
 namespace sycl {
 
+namespace impl {
+
+/*
+ * make_temp_device_pointer slots of sycl_heterogeneous_execution_policy
+ */
+constexpr int heterogeneous_element_order = 22;
+constexpr int heterogeneous_merge_order = 23;
+
+/*
+ * Weight of the last measure in the throughput averages of the calibrated
+ * heterogeneous policy, and smallest share of the elements given to a queue
+ */
+constexpr double heterogeneous_ema_weight = 0.25;
+constexpr float heterogeneous_min_ratio = 0.05f;
+
+/*
+ * Reads the element at ``it`` back to the host
+ */
+template <class ExecutionPolicy, class Iterator>
+typename std::iterator_traits<Iterator>::value_type read_element(
+    ExecutionPolicy &p, Iterator it) {
+  using value_type = typename std::iterator_traits<Iterator>::value_type;
+  cl::sycl::queue q = p.get_queue();
+  value_type *tmp = sycl::helpers::make_temp_device_pointer<
+      value_type, heterogeneous_element_order>(1, q);
+  copy(p, it, std::next(it), tmp);
+  return sycl::helpers::read_device_pointer(tmp, q);
+}
+
+}  // namespace impl
+
 /** class sycl_heterogeneous_execution_policy.
 * @brief Distributes a given workload across two SYCL devices.
 * It takes a float number within the range [0, 1] and it split the workload in
 * two parts (chunk1 = ratio * workload.size() and chunk2 = remaining_workload),
-* then it submits a command group to each device and waits for their completion.
+* then it runs each part on its device at the same time, the second one from
+* the worker thread of its queue, and waits for their completion. Without a ratio, the
+* policy measures both devices and calibrates the split of each algorithm.
+* The algorithms work on USM iterators, which both queues must be able to
+* access, e.g. shared allocations of a context common to both devices.
+* Reductions combine the results of both parts on the host, the second part
+* starting from its first element, read back and mapped on the host. The scans
+* first reduce the first part to get the carry the second part starts from.
+* sort sorts both parts, then merges them on the first device.
 */
 template <class KernelName>
 class sycl_heterogeneous_execution_policy
     : public sycl_execution_policy<KernelName> {
+  using policy_type = sycl_execution_policy<KernelName>;
+
+  /* Throughput of each queue, in elements per second, measured for each
+  * algorithm and smoothed with an exponential moving average
+  */
+  struct throughput_model {
+    std::mutex mutex;
+    std::map<std::string, std::array<double, 2>> throughput;
+    // number of calls timed, the first one of each queue being discarded
+    std::map<std::string, std::array<size_t, 2>> samples;
+  };
+
   cl::sycl::queue q2;
   float ratio;
+  // null when the ratio is fixed by the caller
+  std::shared_ptr<throughput_model> model;
+
+  // Number of the first elements of a range of size n run on the first queue
+  size_t crosspoint(const std::string &algorithm, size_t n) const {
+    return std::min(n, static_cast<size_t>(n * get_ratio(algorithm)));
+  }
+
+  /* Runs f() and records the throughput of the queue ``queue_index`` over
+  * ``elements`` elements, counting ``extra_time`` seconds spent on the same
+  * elements before. The first call of each algorithm on each queue includes
+  * the compilation of its kernels and the allocation of its temporary
+  * memory, so it is not recorded.
+  */
+  template <class F>
+  void timed(const std::string &algorithm, size_t queue_index,
+             size_t elements, F f, double extra_time = 0) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+    const double total_time = time.count() + extra_time;
+    if (!model || elements == 0 || total_time <= 0) {
+      return;
+    }
+    const double measured = elements / total_time;
+    std::lock_guard<std::mutex> lock(model->mutex);
+    if (model->samples[algorithm][queue_index]++ == 0) {
+      return;
+    }
+    auto &throughput = model->throughput[algorithm][queue_index];
+    throughput = (throughput == 0)
+                     ? measured
+                     : (1 - impl::heterogeneous_ema_weight) * throughput +
+                           impl::heterogeneous_ema_weight * measured;
+  }
+
+  /* Runs f(policy, begin, end) on the positions [0, c) with the first queue
+  * and on [c, n) with the second one, concurrently. ``first_extra_time`` is
+  * the time the first queue already spent on its part, e.g. the carry of a
+  * scan.
+  */
+  template <class F>
+  void split_at(const std::string &algorithm, size_t n, size_t c, F f,
+                double first_extra_time = 0) {
+    policy_type p1(this->get_queue());
+    policy_type p2(q2);
+    std::vector<std::future<void>> other;
+    if (c < n) {
+      other.push_back(sycl::helpers::queue_worker::of(q2).run([&] {
+        timed(algorithm, 1, n - c, [&] { f(p2, c, n); });
+      }));
+    }
+    sycl::helpers::run_and_join(other, [&] {
+      if (c > 0) {
+        timed(algorithm, 0, c, [&] { f(p1, size_t{0}, c); },
+              first_extra_time);
+      }
+    });
+  }
+
+  template <class F>
+  void split(const std::string &algorithm, size_t n, F f) {
+    split_at(algorithm, n, crosspoint(algorithm, n), f);
+  }
+
+  /* Reduction of both parts of a range of size n with ``op``:
+  * ``first_part(p, c)`` reduces [0, c) with the initial value, and
+  * ``second_part(p, c, n)`` reduces [c, n) without it.
+  */
+  template <class T, class FirstPart, class SecondPart, class BinaryOperation>
+  T split_reduce(const std::string &algorithm, size_t n, T init,
+                 FirstPart first_part, SecondPart second_part,
+                 BinaryOperation op) {
+    if (n == 0) {
+      return init;
+    }
+    const size_t c = crosspoint(algorithm, n);
+    std::optional<T> res1, res2;
+    split_at(algorithm, n, c, [&](policy_type &p, size_t begin, size_t end) {
+      if (end == c) {
+        res1 = first_part(p, end);
+      } else {
+        res2 = second_part(p, begin, end);
+      }
+    });
+    if (!res1) {
+      return op(init, *res2);
+    }
+    return res2 ? op(*res1, *res2) : *res1;
+  }
 
  public:
+  /* Constructs the policy with a fixed ``ratio_`` of the elements run on
+  * ``q1_``
+  */
   sycl_heterogeneous_execution_policy(cl::sycl::queue q1_, cl::sycl::queue q2_,
                                       float ratio_)
       : sycl_execution_policy<KernelName>(q1_) {
@@ -56,6 +216,88 @@ class sycl_heterogeneous_execution_policy
     ratio = ratio_;
   }
 
+  /* Constructs the policy with a ratio calibrated for each algorithm: both
+  * queues are timed on every call, and the ratio follows the moving average
+  * of their throughputs. The calls of an algorithm split evenly until both
+  * queues are measured past their first, warm-up, call.
+  * Copies of the policy share the measures.
+  */
+  sycl_heterogeneous_execution_policy(cl::sycl::queue q1_, cl::sycl::queue q2_)
+      : sycl_heterogeneous_execution_policy(q1_, q2_, 0.5f) {
+    model = std::make_shared<throughput_model>();
+  }
+
+  /* get_ratio.
+  * @brief Ratio of the elements run on the first queue by the next call of
+  * ``algorithm``, e.g. "transform" or "reduce"
+  */
+  float get_ratio(const std::string &algorithm) const {
+    if (!model) {
+      return ratio;
+    }
+    std::lock_guard<std::mutex> lock(model->mutex);
+    auto it = model->throughput.find(algorithm);
+    if (it == model->throughput.end() || it->second[0] == 0 ||
+        it->second[1] == 0) {
+      return ratio;
+    }
+    const double r = it->second[0] / (it->second[0] + it->second[1]);
+    // both queues keep some work so that their throughputs stay measured
+    return std::clamp(static_cast<float>(r), impl::heterogeneous_min_ratio,
+                      1 - impl::heterogeneous_min_ratio);
+  }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) with a default addition
+   */
+  template <class InputIterator>
+  typename std::iterator_traits<InputIterator>::value_type reduce(
+      InputIterator first, InputIterator last) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return reduce(first, last, type_(0),
+                  [=](type_ v1, type_ v2) { return v1 + v2; });
+  }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) and init with a default
+   * addition
+   */
+  template <class InputIterator, class T>
+  T reduce(InputIterator first, InputIterator last, T init) {
+    return reduce(first, last, init, [=](T v1, T v2) { return v1 + v2; });
+  }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) and init with binop
+   */
+  template <class InputIterator, class T, class BinaryOperation>
+  T reduce(InputIterator first, InputIterator last, T init,
+           BinaryOperation binop) {
+    return split_reduce(
+        "reduce", std::distance(first, last), init,
+        [&](policy_type &p, size_t c) {
+          return impl::reduce(p, first, first + c, init, binop);
+        },
+        [&](policy_type &p, size_t c, size_t n) {
+          T head = impl::read_element(p, first + c);
+          return impl::reduce(p, first + c + 1, first + n, head, binop);
+        },
+        binop);
+  }
+
+  /* transform.
+  * @brief Applies an Unary Operator across the range [b, e).
+  */
+  template <class Iterator, class OutputIterator, class UnaryOperation>
+  OutputIterator transform(Iterator b, Iterator e, OutputIterator out_b,
+                           UnaryOperation op) {
+    const size_t n = std::distance(b, e);
+    split("transform", n, [&](policy_type &p, size_t begin, size_t end) {
+      impl::transform(p, b + begin, b + end, out_b + begin, op);
+    });
+    return out_b + n;
+  }
+
   /* transform.
   * @brief Applies a Binary Operator across the range [first1, last1).
   * Implementation of the command group that submits a transform kernel,
@@ -65,50 +307,246 @@ class sycl_heterogeneous_execution_policy
             class BinaryOperation>
   OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2,
                      OutputIt result, BinaryOperation binary_op) {
-    auto named_sep = getNamedPolicy(*this, binary_op);
-
-    cl::sycl::queue q1 = this->get_queue();
-    int elements = std::distance(first1, last1);
-    int crosspoint = elements * ratio;
-    auto intermediate1(first1 + crosspoint);
-    auto intermediate2(first2 + crosspoint);
-    auto intermediateR(result + crosspoint);
-    int q1_elems = std::distance(first1, intermediate1);
-    int q2_elems = std::distance(intermediate1, last1);
-
-    if (q1_elems < 1) {
-      auto buf1 = sycl::helpers::make_const_buffer(first1, last1);
-      auto buf2 = sycl::helpers::make_const_buffer(first2, first2 + elements);
-      auto res = sycl::helpers::make_buffer(result, result + elements);
-      impl::transform(named_sep, q2, buf1, buf2, res, binary_op);
-      // wait for queues
-      q2.wait_and_throw();
-    } else if (q2_elems < 1) {
-      auto buf1 = sycl::helpers::make_const_buffer(first1, last1);
-      auto buf2 = sycl::helpers::make_const_buffer(first2, first2 + elements);
-      auto res = sycl::helpers::make_buffer(result, result + elements);
-      impl::transform(named_sep, q1, buf1, buf2, res, binary_op);
-      // wait for queues
-      q1.wait_and_throw();
-    } else {
-      auto buf1_q1 =
-          sycl::helpers::make_const_buffer(first1, first1 + crosspoint);
-      auto buf2_q1 =
-          sycl::helpers::make_const_buffer(first2, first2 + crosspoint);
-      auto res_q1 = sycl::helpers::make_buffer(result, result + crosspoint);
-      auto buf1_q2 =
-          sycl::helpers::make_const_buffer(first1 + crosspoint, last1);
-      auto buf2_q2 = sycl::helpers::make_const_buffer(first2 + crosspoint,
-                                                      first2 + elements);
-      auto res_q2 =
-          sycl::helpers::make_buffer(result + crosspoint, result + elements);
-      impl::transform(named_sep, q1, buf1_q1, buf2_q1, res_q1, binary_op);
-      impl::transform(named_sep, q2, buf1_q2, buf2_q2, res_q2, binary_op);
-      // wait for queues
-      q1.wait_and_throw();
-      q2.wait_and_throw();
+    const size_t n = std::distance(first1, last1);
+    split("transform", n, [&](policy_type &p, size_t begin, size_t end) {
+      impl::transform(p, first1 + begin, first1 + end, first2 + begin,
+                      result + begin, binary_op);
+    });
+    return result + n;
+  }
+
+  /* for_each
+   */
+  template <class Iterator, class UnaryFunction>
+  void for_each(Iterator b, Iterator e, UnaryFunction f) {
+    split("for_each", std::distance(b, e),
+          [&](policy_type &p, size_t begin, size_t end) {
+      impl::for_each(p, b + begin, b + end, f);
+    });
+  }
+
+  /* fill.
+  * @brief Assigns value to every element of the range [first, last)
+  */
+  template <class ForwardIt, class T>
+  void fill(ForwardIt first, ForwardIt last, const T &value) {
+    split("fill", std::distance(first, last),
+          [&](policy_type &p, size_t begin, size_t end) {
+      impl::fill(p, first + begin, first + end, value);
+    });
+  }
+
+  /* transform_reduce.
+  * @brief Reduction with binary_op of init and of unary_op applied to the
+  * elements of the range [first, last)
+  */
+  template <class InputIterator, class UnaryOperation, class T,
+            class BinaryOperation>
+  T transform_reduce(InputIterator first, InputIterator last,
+                     UnaryOperation unary_op, T init,
+                     BinaryOperation binary_op) {
+    return split_reduce(
+        "transform_reduce", std::distance(first, last), init,
+        [&](policy_type &p, size_t c) {
+          return impl::transform_reduce(p, first, first + c, unary_op, init,
+                                        binary_op);
+        },
+        [&](policy_type &p, size_t c, size_t n) {
+          T head = unary_op(impl::read_element(p, first + c));
+          return impl::transform_reduce(p, first + c + 1, first + n, unary_op,
+                                        head, binary_op);
+        },
+        binary_op);
+  }
+
+  /* transform_reduce.
+  * @brief Reduction with binary_op of init and of transform_op applied to
+  * the pairs of elements of the ranges [first1, last1) and first2..
+  */
+  template <class InputIt1, class InputIt2, class T, class BinaryOperation1,
+            class BinaryOperation2>
+  T transform_reduce(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init,
+                     BinaryOperation1 binary_op, BinaryOperation2 transform_op) {
+    return split_reduce(
+        "transform_reduce", std::distance(first1, last1), init,
+        [&](policy_type &p, size_t c) {
+          return impl::transform_reduce(p, first1, first1 + c, first2, init,
+                                        binary_op, transform_op);
+        },
+        [&](policy_type &p, size_t c, size_t n) {
+          T head = transform_op(impl::read_element(p, first1 + c),
+                                impl::read_element(p, first2 + c));
+          return impl::transform_reduce(p, first1 + c + 1, first1 + n,
+                                        first2 + c + 1, head, binary_op,
+                                        transform_op);
+        },
+        binary_op);
+  }
+
+  /* count.
+   * @brief Returns the number of elements in the range ``[first, last)``
+   * that are equal to ``value``.
+   */
+  template <class InputIt, class T>
+  typename std::iterator_traits<InputIt>::difference_type count(
+      InputIt first, InputIt last, T value) {
+    return count_if(first, last, [=](T other) { return value == other; });
+  }
+
+  /* count_if.
+  * @brief Returns the number of elements in the range ``[first, last)`` for
+  * which p is true.
+  */
+  template <class InputIt, class UnaryPredicate>
+  typename std::iterator_traits<InputIt>::difference_type count_if(
+      InputIt first, InputIt last, UnaryPredicate p) {
+    using difference_type =
+        typename std::iterator_traits<InputIt>::difference_type;
+    return split_reduce(
+        "count_if", std::distance(first, last), difference_type{0},
+        [&](policy_type &pol, size_t c) {
+          return impl::count_if(pol, first, first + c, p);
+        },
+        [&](policy_type &pol, size_t c, size_t n) {
+          return impl::count_if(pol, first + c, first + n, p);
+        },
+        [](difference_type a, difference_type b) { return a + b; });
+  }
+
+  /** exclusive_scan.
+  * @brief Exclusive scan of the range [first, last) with a default addition
+  */
+  template <class InputIterator, class OutputIterator, class T>
+  OutputIterator exclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator output, T init) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return exclusive_scan(first, last, output, init,
+                          [=](type_ v1, type_ v2) { return v1 + v2; });
+  }
+
+  /** exclusive_scan.
+  * @brief Exclusive scan of the range [first, last) with binary_op. The
+  * second part starts from the reduction of init and of the first part.
+  */
+  template <class InputIterator, class OutputIterator, class T,
+            class BinaryOperation>
+  OutputIterator exclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator output, T init,
+                                BinaryOperation binary_op) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    const size_t n = std::distance(first, last);
+    const size_t c = crosspoint("exclusive_scan", n);
+    policy_type p1(this->get_queue());
+    // the carry has the type of the elements, whatever the type of init
+    const type_ start = static_cast<type_>(init);
+    // the carry is reduced by the first queue, on its own part
+    const auto carry_start = std::chrono::steady_clock::now();
+    const type_ carry =
+        (c < n) ? impl::reduce(p1, first, first + c, start, binary_op) : start;
+    const std::chrono::duration<double> carry_time =
+        std::chrono::steady_clock::now() - carry_start;
+    split_at("exclusive_scan", n, c, [&](policy_type &p, size_t begin, size_t end) {
+      impl::exclusive_scan(p, first + begin, first + end, output + begin,
+                           (begin == 0) ? start : carry, binary_op);
+    }, carry_time.count());
+    return output + n;
+  }
+
+  /** inclusive_scan.
+  * @brief Inclusive scan of the range [first, last) with a default addition
+  */
+  template <class InputIterator, class OutputIterator>
+  OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator d_first) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return inclusive_scan(first, last, d_first,
+                          [=](type_ v1, type_ v2) { return v1 + v2; }, 0);
+  }
+
+  /** inclusive_scan.
+  * @brief Inclusive scan of the range [first, last) with binary_op
+  */
+  template <class InputIterator, class OutputIterator, class BinaryOperation>
+  OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator d_first,
+                                BinaryOperation binary_op) {
+    return inclusive_scan(first, last, d_first, binary_op, 0);
+  }
+
+  /* inclusive_scan.
+  * @brief Inclusive scan of the range [first, last) and init with binary_op.
+  * The second part starts from the reduction of init and of the first part.
+  */
+  template <class InputIterator, class OutputIterator, class BinaryOperation,
+            class T>
+  OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator d_first,
+                                BinaryOperation binary_op, T init) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    const size_t n = std::distance(first, last);
+    const size_t c = crosspoint("inclusive_scan", n);
+    policy_type p1(this->get_queue());
+    // the carry has the type of the elements, whatever the type of init
+    const type_ start = static_cast<type_>(init);
+    // the carry is reduced by the first queue, on its own part
+    const auto carry_start = std::chrono::steady_clock::now();
+    const type_ carry =
+        (c < n) ? impl::reduce(p1, first, first + c, start, binary_op) : start;
+    const std::chrono::duration<double> carry_time =
+        std::chrono::steady_clock::now() - carry_start;
+    split_at("inclusive_scan", n, c, [&](policy_type &p, size_t begin, size_t end) {
+      impl::inclusive_scan(p, first + begin, first + end, d_first + begin,
+                           (begin == 0) ? start : carry, binary_op);
+    }, carry_time.count());
+    return d_first + n;
+  }
+
+  /** sort
+   * @brief Sorts the range [first, last)
+   */
+  template <class RandomAccessIterator>
+  void sort(RandomAccessIterator b, RandomAccessIterator e) {
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+    sort(b, e, std::less<T>());
+  }
+
+  /** sort
+   * @brief Sorts the range [first, last) with comp. Each device sorts its
+   * part, the larger one being put first, then the first device merges them.
+   */
+  template <class RandomIt, class Compare>
+  void sort(RandomIt first, RandomIt last, Compare comp) {
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    const size_t n = std::distance(first, last);
+    const size_t c = crosspoint("sort", n);
+    policy_type p1(this->get_queue());
+    policy_type p2(q2);
+    if (c == 0 || c == n) {
+      impl::sort((c == 0) ? p2 : p1, first, last, comp);
+      return;
     }
-    return last1;
+
+    // merge_blocks_on_gpu needs the first block to be the larger one
+    const bool first_in_front = (c >= n - c);
+    const size_t front = std::max(c, n - c);
+    std::vector<std::future<void>> other;
+    other.push_back(sycl::helpers::queue_worker::of(
+        first_in_front ? q2 : this->get_queue()).run([&] {
+      timed("sort", first_in_front ? 1 : 0, n - front, [&] {
+        impl::sort(first_in_front ? p2 : p1, first + front, last, comp);
+      });
+    }));
+    sycl::helpers::run_and_join(other, [&] {
+      timed("sort", first_in_front ? 0 : 1, front, [&] {
+        impl::sort(first_in_front ? p1 : p2, first, first + front, comp);
+      });
+    });
+
+    cl::sycl::queue q = p1.get_queue();
+    T *merged = sycl::helpers::make_temp_device_pointer<
+        T, impl::heterogeneous_merge_order>(n, q);
+    impl::merge_blocks_on_gpu(p1, first, merged, comp, n, front);
+    impl::copy(p1, merged, merged + n, first);
   }
 };
 
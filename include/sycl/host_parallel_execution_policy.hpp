@@ -0,0 +1,1034 @@
+/* Copyright (c) 2015-2018 The Khronos Group Inc.
+
+  Permission is hereby granted, free of charge, to any person obtaining a
+  copy of this software and/or associated documentation files (the
+  "Materials"), to deal in the Materials without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Materials, and to
+  permit persons to whom the Materials are furnished to do so, subject to
+  the following conditions:
+
+  The above copyright notice and this permission notice shall be included
+  in all copies or substantial portions of the Materials.
+
+  MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+  KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+  SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+     https://www.khronos.org/registry/
+
+  THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+*/
+
+#ifndef __SYCL_HOST_PARALLEL_EXECUTION_POLICY__
+#define __SYCL_HOST_PARALLEL_EXECUTION_POLICY__
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <sycl/helpers/sycl_differences.hpp>
+#include <sycl/helpers/sycl_host_thread_pool.hpp>
+
+namespace sycl {
+
+namespace impl {
+
+/*
+ * Smallest block of host_parallel_execution_policy, so that every task runs
+ * a loop long enough to hide its scheduling
+ */
+constexpr size_t host_min_block = 1 << 12;
+
+/*
+ * Elements between two checks of the position found by the other blocks, in
+ * the searches of host_parallel_execution_policy
+ */
+constexpr size_t host_search_stride = 1 << 10;
+
+}  // namespace impl
+
+/** class host_parallel_execution_policy.
+* @brief Runs the algorithms on the host, on a pool of threads with work
+* stealing, see sycl::helpers::host_thread_pool, without any SYCL device.
+* The ranges are divided into contiguous blocks of at least
+* impl::host_min_block elements, about ``blocks_per_thread`` per thread, and
+* every block runs a plain loop which the compiler can vectorise. Reductions
+* and scans combine the blocks in order, so their operation only needs to be
+* associative. The policy implements the algorithms of sycl_execution_policy,
+* so that it can be given to the same std::experimental::parallel functions,
+* as well as copy, copy_if and reduce_by_key.
+*/
+class host_parallel_execution_policy {
+  sycl::helpers::host_thread_pool *m_pool;
+  size_t m_blocks_per_thread;
+
+  size_t block_size(size_t n) const {
+    const size_t blocks = m_pool->size() * m_blocks_per_thread;
+    return std::max(impl::host_min_block, (n + blocks - 1) / blocks);
+  }
+
+  // Number of blocks of a range of n elements
+  size_t nb_blocks(size_t n) const {
+    const size_t block = block_size(n);
+    return (n + block - 1) / block;
+  }
+
+  /* Calls f(block, begin, end) for every block [begin, end) of [0, n), the
+  * blocks being numbered from 0 to nb_blocks(n)
+  */
+  template <class F>
+  void for_blocks(size_t n, F f) {
+    const size_t block = block_size(n);
+    m_pool->parallel_for(nb_blocks(n), [&](size_t b) {
+      f(b, b * block, std::min(n, (b + 1) * block));
+    });
+  }
+
+  // Calls a copy of f, one per block, on every i in [0, n)
+  template <class F>
+  void for_each_index(size_t n, F f) {
+    for_blocks(n, [&](size_t, size_t begin, size_t end) {
+      F g = f;
+      for (size_t i = begin; i < end; i++) {
+        g(i);
+      }
+    });
+  }
+
+  // Reduction with ``op`` of init and of map(i) for every i in [0, n)
+  template <class T, class Map, class BinaryOperation>
+  T map_reduce(size_t n, T init, Map map, BinaryOperation op) {
+    std::vector<std::optional<T>> partials(nb_blocks(n));
+    for_blocks(n, [&](size_t b, size_t begin, size_t end) {
+      T acc = map(begin);
+      for (size_t i = begin + 1; i < end; i++) {
+        acc = op(acc, map(i));
+      }
+      partials[b] = acc;
+    });
+    for (const auto &partial : partials) {
+      init = op(init, *partial);
+    }
+    return init;
+  }
+
+  /* Scan with ``op`` of init and of [first, first + n) into o. The blocks
+  * are reduced, the carries of the blocks scanned, then every block scanned
+  * from its carry.
+  */
+  template <class InputIt, class OutputIt, class T, class BinaryOperation>
+  OutputIt scan(InputIt first, size_t n, OutputIt o, T init,
+                BinaryOperation op, bool inclusive) {
+    std::vector<std::optional<T>> carries(nb_blocks(n));
+    for_blocks(n, [&](size_t b, size_t begin, size_t end) {
+      T acc = first[begin];
+      for (size_t i = begin + 1; i < end; i++) {
+        acc = op(acc, first[i]);
+      }
+      carries[b] = acc;
+    });
+    for (auto &carry : carries) {
+      T next = op(init, *carry);
+      carry = init;
+      init = next;
+    }
+    for_blocks(n, [&](size_t b, size_t begin, size_t end) {
+      T acc = *carries[b];
+      for (size_t i = begin; i < end; i++) {
+        // read before the write, o may be first
+        const T x = first[i];
+        if (inclusive) {
+          acc = op(acc, x);
+          o[i] = acc;
+        } else {
+          o[i] = acc;
+          acc = op(acc, x);
+        }
+      }
+    });
+    return o + n;
+  }
+
+  // Smallest i in [0, n) for which pred(i) is true, n if there is none
+  template <class Predicate>
+  size_t find_index(size_t n, Predicate pred) {
+    std::atomic<size_t> found{n};
+    for_blocks(n, [&](size_t, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        if ((i - begin) % impl::host_search_stride == 0 &&
+            found.load(std::memory_order_relaxed) <= i) {
+          return;
+        }
+        if (pred(i)) {
+          size_t current = found.load(std::memory_order_relaxed);
+          while (i < current && !found.compare_exchange_weak(current, i)) {
+          }
+          return;
+        }
+      }
+    });
+    return found.load();
+  }
+
+  /* Copies the elements first[i] for which keep(i) is true to o, in order,
+  * and returns the end of the copy. The kept elements of every block are
+  * counted, then copied from the offset given by the counts of the
+  * previous blocks.
+  */
+  template <class InputIt, class OutputIt, class Keep>
+  OutputIt compact(InputIt first, size_t n, OutputIt o, Keep keep) {
+    std::vector<size_t> offsets(nb_blocks(n) + 1, 0);
+    for_blocks(n, [&](size_t b, size_t begin, size_t end) {
+      size_t kept = 0;
+      for (size_t i = begin; i < end; i++) {
+        kept += keep(i) ? 1 : 0;
+      }
+      offsets[b + 1] = kept;
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for_blocks(n, [&](size_t b, size_t begin, size_t end) {
+      OutputIt out = o + offsets[b];
+      for (size_t i = begin; i < end; i++) {
+        if (keep(i)) {
+          *out = first[i];
+          ++out;
+        }
+      }
+    });
+    return o + offsets.back();
+  }
+
+  // Moves [tmp.begin(), tmp.end()) back to first
+  template <class T, class Iterator>
+  void move_back(std::vector<T> &tmp, Iterator first) {
+    for_each_index(tmp.size(),
+                   [&](size_t i) { first[i] = std::move(tmp[i]); });
+  }
+
+ public:
+  /* Constructs the policy on ``pool``, the pool of the host policies by
+  * default
+  */
+  host_parallel_execution_policy(
+      sycl::helpers::host_thread_pool &pool =
+          sycl::helpers::host_thread_pool::default_pool(),
+      size_t blocks_per_thread = 4)
+      : m_pool(&pool),
+        m_blocks_per_thread(std::max<size_t>(blocks_per_thread, 1)) {}
+
+  host_parallel_execution_policy(const host_parallel_execution_policy &) =
+      default;
+
+  // Returns the thread pool of the policy
+  sycl::helpers::host_thread_pool &get_pool() const { return *m_pool; }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) with a default addition
+   */
+  template <class InputIterator>
+  typename std::iterator_traits<InputIterator>::value_type reduce(
+      InputIterator first, InputIterator last) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return reduce(first, last, type_(0),
+                  [=](type_ v1, type_ v2) { return v1 + v2; });
+  }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) and init with a default
+   * addition
+   */
+  template <class InputIterator, class T>
+  T reduce(InputIterator first, InputIterator last, T init) {
+    return reduce(first, last, init, [=](T v1, T v2) { return v1 + v2; });
+  }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) and init with binop
+   */
+  template <class InputIterator, class T, class BinaryOperation>
+  T reduce(InputIterator first, InputIterator last, T init,
+           BinaryOperation binop) {
+    return map_reduce(sycl::helpers::distance(first, last), init,
+                      [&](size_t i) -> T { return first[i]; }, binop);
+  }
+
+  /** sort
+   * @brief Sorts the range [first, last) with operator<
+   */
+  template <class RandomAccessIterator>
+  void sort(RandomAccessIterator b, RandomAccessIterator e) {
+    sort(b, e, std::less<>());
+  }
+
+  /** sort
+   * @brief Sorts the range [first, last) with comp. The blocks are sorted
+   * on their own, then merged pairwise in rounds, every merge being split
+   * into blocks of the output whose inputs are found by a binary search
+   * along the merge path, so that the last rounds still use every thread.
+   */
+  template <class RandomIt, class Compare>
+  void sort(RandomIt first, RandomIt last, Compare comp) {
+    using value_type = typename std::iterator_traits<RandomIt>::value_type;
+    const size_t n = sycl::helpers::distance(first, last);
+    const size_t block = block_size(n);
+    for_blocks(n, [&](size_t, size_t begin, size_t end) {
+      std::sort(first + begin, first + end, comp);
+    });
+    if (n <= block) {
+      return;
+    }
+
+    std::vector<value_type> tmp(first, last);
+    // merges the runs of ``width`` elements of src into dst
+    auto merge_round = [&](auto src, auto dst, size_t width) {
+      for_blocks(n, [&](size_t, size_t begin, size_t end) {
+        const size_t run = begin - begin % (2 * width);
+        const size_t middle = std::min(n, run + width);
+        const size_t run_end = std::min(n, run + 2 * width);
+        const size_t la = middle - run;
+        const size_t lb = run_end - middle;
+        auto a = src + run;
+        auto b = src + middle;
+        // number of elements of a among the first d of the merge
+        auto co_rank = [&](size_t d) {
+          size_t lo = (d > lb) ? d - lb : 0;
+          size_t hi = std::min(d, la);
+          while (lo < hi) {
+            const size_t mid = lo + (hi - lo + 1) / 2;
+            if (!comp(b[d - mid], a[mid - 1])) {
+              lo = mid;
+            } else {
+              hi = mid - 1;
+            }
+          }
+          return lo;
+        };
+        const size_t i0 = co_rank(begin - run);
+        const size_t i1 = co_rank(end - run);
+        std::merge(a + i0, a + i1, b + (begin - run - i0),
+                   b + (end - run - i1), dst + begin, comp);
+      });
+    };
+
+    bool in_tmp = false;
+    for (size_t width = block; width < n; width *= 2) {
+      if (in_tmp) {
+        merge_round(tmp.begin(), first, width);
+      } else {
+        merge_round(first, tmp.begin(), width);
+      }
+      in_tmp = !in_tmp;
+    }
+    if (in_tmp) {
+      move_back(tmp, first);
+    }
+  }
+
+  /* transform.
+  * @brief Applies an Unary Operator across the range [b, e).
+  */
+  template <class Iterator, class OutputIterator, class UnaryOperation>
+  OutputIterator transform(Iterator b, Iterator e, OutputIterator out_b,
+                           UnaryOperation op) {
+    const size_t n = sycl::helpers::distance(b, e);
+    for_each_index(n, [&](size_t i) { out_b[i] = op(b[i]); });
+    return out_b + n;
+  }
+
+  /* transform.
+  * @brief Applies a Binary Operator across the range [first1, last1).
+  */
+  template <class InputIt1, class InputIt2, class OutputIt,
+            class BinaryOperation>
+  OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                     OutputIt result, BinaryOperation binary_op) {
+    const size_t n = sycl::helpers::distance(first1, last1);
+    for_each_index(n,
+                   [&](size_t i) { result[i] = binary_op(first1[i], first2[i]); });
+    return result + n;
+  }
+
+  /* for_each
+   */
+  template <class Iterator, class UnaryFunction>
+  void for_each(Iterator b, Iterator e, UnaryFunction f) {
+    for_each_index(sycl::helpers::distance(b, e), [&](size_t i) { f(b[i]); });
+  }
+
+  /* for_each_n.
+  * @brief Applies a Function across the range [first, first + n).
+  */
+  template <class InputIterator, class Size, class Function>
+  InputIterator for_each_n(InputIterator first, Size n, Function f) {
+    if (n <= 0) {
+      return first;
+    }
+    for_each(first, first + n, f);
+    return first + n;
+  }
+
+  /* inner_product.
+  * @brief Reduction with op1 of value and of op2 applied to the pairs of
+  * elements of the range [first1, last1) and of the range starting at first2
+  */
+  template <class InputIt1, class InputIt2, class T,
+            class BinaryOperation1 = decltype(std::plus<T>()),
+            class BinaryOperation2 = decltype(std::multiplies<T>())>
+  T inner_product(InputIt1 first1, InputIt1 last1, InputIt2 first2, T value,
+                  BinaryOperation1 op1 = std::plus<T>(),
+                  BinaryOperation2 op2 = std::multiplies<T>()) {
+    return transform_reduce(first1, last1, first2, value, op1, op2);
+  }
+
+  /* transform_reduce.
+  * @brief Reduction with binary_op of init and of unary_op applied to the
+  * elements of the range [first, last)
+  */
+  template <class InputIterator, class UnaryOperation, class T,
+            class BinaryOperation>
+  T transform_reduce(InputIterator first, InputIterator last,
+                     UnaryOperation unary_op, T init,
+                     BinaryOperation binary_op) {
+    return map_reduce(sycl::helpers::distance(first, last), init,
+                      [&](size_t i) -> T { return unary_op(first[i]); },
+                      binary_op);
+  }
+
+  /* transform_reduce.
+  * @brief Reduction with binary_op of init and of transform_op applied to
+  * the pairs of elements of the ranges [first1, last1) and first2..
+  */
+  template <class InputIt1, class InputIt2, class T, class BinaryOperation1,
+            class BinaryOperation2>
+  T transform_reduce(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init,
+                     BinaryOperation1 binary_op, BinaryOperation2 transform_op) {
+    return map_reduce(
+        sycl::helpers::distance(first1, last1), init,
+        [&](size_t i) -> T { return transform_op(first1[i], first2[i]); },
+        binary_op);
+  }
+
+  /* count.
+   * @brief Returns the number of elements in the range ``[first, last)``
+   * that are equal to ``value``.
+   */
+  template <class InputIt, class T>
+  typename std::iterator_traits<InputIt>::difference_type count(
+      InputIt first, InputIt last, T value) {
+    return count_if(first, last, [=](T other) { return value == other; });
+  }
+
+  /* count_if.
+  * @brief Returns the number of elements in the range ``[first, last)`` for
+  * which p is true.
+  */
+  template <class InputIt, class UnaryPredicate>
+  typename std::iterator_traits<InputIt>::difference_type count_if(
+      InputIt first, InputIt last, UnaryPredicate p) {
+    using difference_type =
+        typename std::iterator_traits<InputIt>::difference_type;
+    return map_reduce(
+        sycl::helpers::distance(first, last), difference_type{0},
+        [&](size_t i) -> difference_type { return p(first[i]) ? 1 : 0; },
+        std::plus<difference_type>());
+  }
+
+  /** exclusive_scan.
+  * @brief Exclusive scan of the range [first, last) starting from init, with
+  * a default addition
+  */
+  template <class InputIterator, class OutputIterator, class T>
+  OutputIterator exclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator output, T init) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return exclusive_scan(first, last, output, init,
+                          [=](type_ v1, type_ v2) { return v1 + v2; });
+  }
+
+  /** exclusive_scan.
+  * @brief Exclusive scan of the range [first, last) starting from init, with
+  * binary_op
+  */
+  template <class InputIterator, class OutputIterator, class T,
+            class BinaryOperation>
+  OutputIterator exclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator output, T init,
+                                BinaryOperation binary_op) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return scan(first, sycl::helpers::distance(first, last), output,
+                static_cast<type_>(init), binary_op, false);
+  }
+
+  /** inclusive_scan.
+  * @brief Inclusive scan of the range [first, last) with a default addition
+  */
+  template <class InputIterator, class OutputIterator>
+  OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator d_first) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return inclusive_scan(first, last, d_first,
+                          [=](type_ v1, type_ v2) { return v1 + v2; }, 0);
+  }
+
+  /** inclusive_scan.
+  * @brief Inclusive scan of the range [first, last) with binary_op
+  */
+  template <class InputIterator, class OutputIterator, class BinaryOperation>
+  OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator d_first,
+                                BinaryOperation binary_op) {
+    return inclusive_scan(first, last, d_first, binary_op, 0);
+  }
+
+  /* inclusive_scan.
+  * @brief Inclusive scan of init and of the range [first, last) with
+  * binary_op
+  */
+  template <class InputIterator, class OutputIterator, class BinaryOperation,
+            class T>
+  OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator d_first,
+                                BinaryOperation binary_op, T init) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return scan(first, sycl::helpers::distance(first, last), d_first,
+                static_cast<type_>(init), binary_op, true);
+  }
+
+  /** find
+  * @brief Returns an iterator to the first position at which value can be found
+  * in the range [first, last)
+  */
+  template <class InputIt, class T>
+  InputIt find(InputIt first, InputIt last, T value) {
+    return find_if(first, last, [=](T other) { return value == other; });
+  }
+
+  /** find_if
+  * @brief Returns an iterator to the first position at which the predicate P
+  * is true in the range [first, last)
+  */
+  template <class InputIt, class UnaryPredicate>
+  InputIt find_if(InputIt first, InputIt last, UnaryPredicate P) {
+    return first + find_index(sycl::helpers::distance(first, last),
+                              [&](size_t i) { return P(first[i]); });
+  }
+
+  /** find_if_not
+  * @brief Returns an iterator to the first position at which the predicate P
+  * is false in the range [first, last)
+  */
+  template <class InputIt, class UnaryPredicate>
+  InputIt find_if_not(InputIt first, InputIt last, UnaryPredicate P) {
+    typedef typename std::iterator_traits<InputIt>::value_type type_;
+    return find_if(first, last, [=](type_ other) { return !P(other); });
+  }
+
+  /** fill
+  * @brief Assigns value to every element of the range [first, last)
+  */
+  template <class ForwardIt, class T>
+  void fill(ForwardIt first, ForwardIt last, const T& value) {
+    for_each_index(sycl::helpers::distance(first, last),
+                   [&](size_t i) { first[i] = value; });
+  }
+
+  /** fill_n.
+   * @brief Assigns value to the range ``[first, first + count)`` if
+   * ``count > 0``
+   */
+  template <class ForwardIt, class Size, class T>
+  void fill_n(ForwardIt first, Size count, const T& value) {
+    if (count > 0) {
+      fill(first, first + count, value);
+    }
+  }
+
+  /** generate.
+   * @brief Assigns each element in range ``[first, last)`` a value generated
+   * by a copy of ``g``, one per block.
+   */
+  template <class ForwardIt, class Generator>
+  void generate(ForwardIt first, ForwardIt last, Generator g) {
+    for_each_index(sycl::helpers::distance(first, last),
+                   [first, g](size_t i) mutable { first[i] = g(); });
+  }
+
+  /** generate_n.
+   * @brief Assigns values generated by g to the range ``[first, first +
+   * count)`` if ``count > 0``
+   */
+  template <class ForwardIt, class Size, class Generator>
+  void generate_n(ForwardIt first, Size count, Generator g) {
+    if (count > 0) {
+      generate(first, first + count, g);
+    }
+  }
+
+  /** reverse
+   * @brief Reverses the order of the elements in the range ``[first,last)``.
+   */
+  template <class BidirIt>
+  void reverse(BidirIt first, BidirIt last) {
+    using std::swap;
+    const size_t n = sycl::helpers::distance(first, last);
+    for_each_index(n / 2, [&](size_t i) { swap(first[i], first[n - 1 - i]); });
+  }
+
+  /** reverse_copy
+   * @brief Copies the range [first, last) to d_first in reverse order
+   */
+  template <class BidirIt, class ForwardIt>
+  ForwardIt reverse_copy(BidirIt first, BidirIt last, ForwardIt d_first) {
+    const size_t n = sycl::helpers::distance(first, last);
+    for_each_index(n, [&](size_t i) { d_first[i] = first[n - 1 - i]; });
+    return d_first + n;
+  }
+
+  /** replace_if
+   * @brief  Replaces all elements for which predicate ``p`` returns ``true``
+   * with ``new_value`` in the range ``[first, last)``.
+   */
+  template <class ForwardIt, class UnaryPredicate, class T>
+  void replace_if(ForwardIt first, ForwardIt last, UnaryPredicate p,
+                  const T& new_value) {
+    for_each_index(sycl::helpers::distance(first, last), [&](size_t i) {
+      if (p(first[i])) {
+        first[i] = new_value;
+      }
+    });
+  }
+
+  /** replace
+   * @brief  Replaces all elements that are equal to ``old_value`` with
+   * ``new_value`` in the range ``[first, last)``.
+   */
+  template <class ForwardIt, class T>
+  void replace(ForwardIt first, ForwardIt last, const T& old_value,
+               const T& new_value) {
+    T old_val = old_value;
+    replace_if(first, last, [=](T other) { return other == old_val; },
+               new_value);
+  }
+
+  /** replace_copy_if
+   * @brief Copies the range ``[first, last)`` to ``d_first``, replacing the
+   * elements for which ``p`` is true with ``new_value``.
+   */
+  template <class ForwardIt1, class ForwardIt2, class UnaryPredicate, class T>
+  ForwardIt2 replace_copy_if(ForwardIt1 first, ForwardIt1 last,
+                             ForwardIt2 d_first, UnaryPredicate p,
+                             const T& new_value) {
+    const size_t n = sycl::helpers::distance(first, last);
+    for_each_index(n, [&](size_t i) {
+      d_first[i] = p(first[i]) ? new_value : first[i];
+    });
+    return d_first + n;
+  }
+
+  /** replace_copy
+   * @brief Copies the range ``[first, last)`` to ``d_first``, replacing the
+   * elements equal to ``old_value`` with ``new_value``.
+   */
+  template <class ForwardIt1, class ForwardIt2, class T>
+  ForwardIt2 replace_copy(ForwardIt1 first, ForwardIt1 last, ForwardIt2 d_first,
+                          const T& old_value, const T& new_value) {
+    T old_val = old_value;
+    return replace_copy_if(first, last, d_first,
+                           [=](T other) { return other == old_val; },
+                           new_value);
+  }
+
+  /** copy
+   * @brief Copies the range ``[first, last)`` to ``d_first``.
+   */
+  template <class InputIt, class OutputIt>
+  OutputIt copy(InputIt first, InputIt last, OutputIt d_first) {
+    const size_t n = sycl::helpers::distance(first, last);
+    for_each_index(n, [&](size_t i) { d_first[i] = first[i]; });
+    return d_first + n;
+  }
+
+  /** copy_if
+   * @brief Copies the elements of the range ``[first, last)`` for which
+   * ``p`` is true to ``d_first``, keeping their order.
+   */
+  template <class InputIt, class OutputIt, class UnaryPredicate>
+  OutputIt copy_if(InputIt first, InputIt last, OutputIt d_first,
+                   UnaryPredicate p) {
+    return compact(first, sycl::helpers::distance(first, last), d_first,
+                   [&](size_t i) { return p(first[i]); });
+  }
+
+  /** remove_copy_if
+   * @brief Copies the elements of the range ``[first, last)`` for which
+   * ``p`` is false to ``d_first``, keeping their order.
+   */
+  template <class ForwardIt1, class ForwardIt2, class UnaryPredicate>
+  ForwardIt2 remove_copy_if(ForwardIt1 first, ForwardIt1 last,
+                            ForwardIt2 d_first, UnaryPredicate p) {
+    return compact(first, sycl::helpers::distance(first, last), d_first,
+                   [&](size_t i) { return !p(first[i]); });
+  }
+
+  /** remove_copy
+   * @brief Copies the elements of the range ``[first, last)`` not equal to
+   * ``value`` to ``d_first``, keeping their order.
+   */
+  template <class ForwardIt1, class ForwardIt2, class T>
+  ForwardIt2 remove_copy(ForwardIt1 first, ForwardIt1 last, ForwardIt2 d_first,
+                         const T& value) {
+    return remove_copy_if(first, last, d_first,
+                          [&](const T& other) { return other == value; });
+  }
+
+  /** remove_if
+   * @brief Removes the elements for which ``p`` is true from the range
+   * ``[first, last)``, keeping the order of the others, which are compacted
+   * into a temporary vector and moved back.
+   */
+  template <class ForwardIt, class UnaryPredicate>
+  ForwardIt remove_if(ForwardIt first, ForwardIt last, UnaryPredicate p) {
+    using value_type = typename std::iterator_traits<ForwardIt>::value_type;
+    const size_t n = sycl::helpers::distance(first, last);
+    std::vector<value_type> tmp(n);
+    tmp.erase(remove_copy_if(first, last, tmp.begin(), p), tmp.end());
+    move_back(tmp, first);
+    return first + tmp.size();
+  }
+
+  /** remove
+   * @brief Removes the elements equal to ``value`` from the range
+   * ``[first, last)``, keeping the order of the others.
+   */
+  template <class ForwardIt, class T>
+  ForwardIt remove(ForwardIt first, ForwardIt last, const T& value) {
+    return remove_if(first, last,
+                     [&](const T& other) { return other == value; });
+  }
+
+  /** rotate_copy
+   * @brief Copies the range ``[first, last)`` to ``result`` so that
+   * ``middle`` becomes its first element
+   */
+  template <class ForwardIt1, class ForwardIt2>
+  ForwardIt2 rotate_copy(ForwardIt1 first, ForwardIt1 middle, ForwardIt1 last,
+                         ForwardIt2 result) {
+    const size_t n = sycl::helpers::distance(first, last);
+    const size_t shift = sycl::helpers::distance(first, middle);
+    for_each_index(n, [&](size_t i) {
+      result[i] = first[(i < n - shift) ? i + shift : i + shift - n];
+    });
+    return result + n;
+  }
+
+  /** rotate
+   * @brief Performs a left rotation of the range ``[first, last)`` so that
+   * ``middle`` becomes its first element, through a temporary vector
+   */
+  template <class ForwardIt>
+  ForwardIt rotate(ForwardIt first, ForwardIt middle, ForwardIt last) {
+    using value_type = typename std::iterator_traits<ForwardIt>::value_type;
+    std::vector<value_type> tmp(sycl::helpers::distance(first, last));
+    rotate_copy(first, middle, last, tmp.begin());
+    move_back(tmp, first);
+    return first + (last - middle);
+  }
+
+  /** all_of
+   * @brief Checks if ``p`` is true for all the elements of the range
+   */
+  template <class ForwardIt, class UnaryPredicate>
+  bool all_of(ForwardIt first, ForwardIt last, UnaryPredicate p) {
+    return find_if_not(first, last, p) == last;
+  }
+
+  /** any_of
+   * @brief Checks if ``p`` is true for at least one element of the range
+   */
+  template <class InputIt, class UnaryPredicate>
+  bool any_of(InputIt first, InputIt last, UnaryPredicate p) {
+    return find_if(first, last, p) != last;
+  }
+
+  /** none_of
+   * @brief Checks if ``p`` is true for no element of the range
+   */
+  template <class InputIt, class UnaryPredicate>
+  bool none_of(InputIt first, InputIt last, UnaryPredicate p) {
+    return !any_of(first, last, p);
+  }
+
+  /** equal
+   * @brief Whether the range ``[first1, last1)`` is equal to the range
+   * starting at ``first2``
+   */
+  template <class ForwardIt1, class ForwardIt2>
+  bool equal(ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2) {
+    return equal(first1, last1, first2, first2 + (last1 - first1));
+  }
+
+  /** equal
+   * @brief Whether the range ``[first1, last1)`` is equal to the range
+   * starting at ``first2``, the elements being compared with ``p``
+   */
+  template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+  bool equal(ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
+             BinaryPredicate p) {
+    return equal(first1, last1, first2, first2 + (last1 - first1), p);
+  }
+
+  /** equal
+   * @brief Whether the ranges ``[first1, last1)`` and ``[first2, last2)`` are
+   * equal
+   */
+  template <class ForwardIt1, class ForwardIt2>
+  bool equal(ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
+             ForwardIt2 last2) {
+    return equal(first1, last1, first2, last2, std::equal_to<>{});
+  }
+
+  /** equal
+   * @brief Whether the ranges ``[first1, last1)`` and ``[first2, last2)`` are
+   * equal, the elements being compared with ``p``
+   */
+  template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+  bool equal(ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
+             ForwardIt2 last2, BinaryPredicate p) {
+    const size_t n = sycl::helpers::distance(first1, last1);
+    if (n != sycl::helpers::distance(first2, last2)) {
+      return false;
+    }
+    return find_index(n, [&](size_t i) { return !p(first1[i], first2[i]); }) ==
+           n;
+  }
+
+  /** mismatch
+   * @brief First mismatching pair of elements of the range ``[first1,
+   * last1)`` and of the range starting at ``first2``
+   */
+  template <class ForwardIt1, class ForwardIt2>
+  std::pair<ForwardIt1, ForwardIt2> mismatch(ForwardIt1 first1,
+                                             ForwardIt1 last1,
+                                             ForwardIt2 first2) {
+    return mismatch(first1, last1, first2, first2 + (last1 - first1));
+  }
+
+  /** mismatch
+   * @brief First mismatching pair of elements of the range ``[first1,
+   * last1)`` and of the range starting at ``first2``, compared with ``p``
+   */
+  template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+  std::pair<ForwardIt1, ForwardIt2> mismatch(ForwardIt1 first1,
+                                             ForwardIt1 last1,
+                                             ForwardIt2 first2,
+                                             BinaryPredicate p) {
+    return mismatch(first1, last1, first2, first2 + (last1 - first1), p);
+  }
+
+  /** mismatch
+   * @brief First mismatching pair of elements of the ranges ``[first1,
+   * last1)`` and ``[first2, last2)``
+   */
+  template <class ForwardIt1, class ForwardIt2>
+  std::pair<ForwardIt1, ForwardIt2> mismatch(ForwardIt1 first1,
+                                             ForwardIt1 last1,
+                                             ForwardIt2 first2,
+                                             ForwardIt2 last2) {
+    return mismatch(first1, last1, first2, last2, std::equal_to<>{});
+  }
+
+  /** mismatch
+   * @brief First mismatching pair of elements of the ranges ``[first1,
+   * last1)`` and ``[first2, last2)``, compared with ``p``
+   */
+  template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+  std::pair<ForwardIt1, ForwardIt2> mismatch(ForwardIt1 first1,
+                                             ForwardIt1 last1,
+                                             ForwardIt2 first2,
+                                             ForwardIt2 last2,
+                                             BinaryPredicate p) {
+    const size_t n = std::min(sycl::helpers::distance(first1, last1),
+                              sycl::helpers::distance(first2, last2));
+    const size_t i =
+        find_index(n, [&](size_t j) { return !p(first1[j], first2[j]); });
+    return std::make_pair(first1 + i, first2 + i);
+  }
+
+  /** min_element
+   * @brief Iterator to the first smallest element of the range
+   */
+  template <class ForwardIt>
+  ForwardIt min_element(ForwardIt first, ForwardIt last) {
+    return min_element(first, last, std::less<>());
+  }
+
+  /** min_element
+   * @brief Iterator to the first smallest element of the range according to
+   * ``comp``
+   */
+  template <class ForwardIt, class Compare>
+  ForwardIt min_element(ForwardIt first, ForwardIt last, Compare comp) {
+    const size_t n = sycl::helpers::distance(first, last);
+    std::vector<ForwardIt> partials(nb_blocks(n));
+    for_blocks(n, [&](size_t b, size_t begin, size_t end) {
+      partials[b] = std::min_element(first + begin, first + end, comp);
+    });
+    ForwardIt res = last;
+    for (ForwardIt partial : partials) {
+      if (res == last || comp(*partial, *res)) {
+        res = partial;
+      }
+    }
+    return res;
+  }
+
+  /** max_element
+   * @brief Iterator to the first greatest element of the range
+   */
+  template <class ForwardIt>
+  ForwardIt max_element(ForwardIt first, ForwardIt last) {
+    return max_element(first, last, std::less<>());
+  }
+
+  /** max_element
+   * @brief Iterator to the first greatest element of the range according to
+   * ``comp``
+   */
+  template <class ForwardIt, class Compare>
+  ForwardIt max_element(ForwardIt first, ForwardIt last, Compare comp) {
+    const size_t n = sycl::helpers::distance(first, last);
+    std::vector<ForwardIt> partials(nb_blocks(n));
+    for_blocks(n, [&](size_t b, size_t begin, size_t end) {
+      partials[b] = std::max_element(first + begin, first + end, comp);
+    });
+    ForwardIt res = last;
+    for (ForwardIt partial : partials) {
+      if (res == last || comp(*res, *partial)) {
+        res = partial;
+      }
+    }
+    return res;
+  }
+
+  /** minmax_element
+   * @brief Iterators to the first smallest and the last greatest elements
+   * of the range
+   */
+  template <class ForwardIt>
+  std::pair<ForwardIt, ForwardIt> minmax_element(ForwardIt first,
+                                                 ForwardIt last) {
+    return minmax_element(first, last, std::less<>());
+  }
+
+  /** minmax_element
+   * @brief Iterators to the first smallest and the last greatest elements
+   * of the range according to ``comp``
+   */
+  template <class ForwardIt, class Compare>
+  std::pair<ForwardIt, ForwardIt> minmax_element(ForwardIt first,
+                                                 ForwardIt last,
+                                                 Compare comp) {
+    const size_t n = sycl::helpers::distance(first, last);
+    std::vector<std::pair<ForwardIt, ForwardIt>> partials(nb_blocks(n));
+    for_blocks(n, [&](size_t b, size_t begin, size_t end) {
+      partials[b] = std::minmax_element(first + begin, first + end, comp);
+    });
+    auto res = std::make_pair(last, last);
+    for (const auto &partial : partials) {
+      if (res.first == last || comp(*partial.first, *res.first)) {
+        res.first = partial.first;
+      }
+      if (res.second == last || !comp(*partial.second, *res.second)) {
+        res.second = partial.second;
+      }
+    }
+    return res;
+  }
+
+  /** reduce_by_key
+   * @brief Reduces with ``op`` the values of every run of consecutive equal
+   * keys, according to ``pred``, and writes the key and the reduction of
+   * each run to keys_output and values_output. The heads of the runs are
+   * counted in every block, then each block reduces the runs which start in
+   * it, reading past its end when they do.
+   */
+  template <class InputIt1, class InputIt2, class OutputIt1, class OutputIt2,
+            class BinaryPredicate, class BinaryOperation>
+  std::pair<OutputIt1, OutputIt2> reduce_by_key(
+      InputIt1 keys_first, InputIt1 keys_last, InputIt2 values_first,
+      OutputIt1 keys_output, OutputIt2 values_output, BinaryPredicate pred,
+      BinaryOperation op) {
+    using value_type = typename std::iterator_traits<InputIt2>::value_type;
+    const size_t n = sycl::helpers::distance(keys_first, keys_last);
+    auto head = [&](size_t i) {
+      return i == 0 || !pred(keys_first[i - 1], keys_first[i]);
+    };
+    std::vector<size_t> offsets(nb_blocks(n) + 1, 0);
+    for_blocks(n, [&](size_t b, size_t begin, size_t end) {
+      size_t heads = 0;
+      for (size_t i = begin; i < end; i++) {
+        heads += head(i) ? 1 : 0;
+      }
+      offsets[b + 1] = heads;
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for_blocks(n, [&](size_t b, size_t begin, size_t end) {
+      size_t out = offsets[b];
+      for (size_t i = begin; i < end; i++) {
+        if (!head(i)) {
+          continue;
+        }
+        value_type acc = values_first[i];
+        for (size_t j = i + 1; j < n && !head(j); j++) {
+          acc = op(acc, values_first[j]);
+        }
+        keys_output[out] = keys_first[i];
+        values_output[out] = acc;
+        out++;
+      }
+    });
+    return std::make_pair(keys_output + offsets.back(),
+                          values_output + offsets.back());
+  }
+
+  /** reduce_by_key
+   * @brief reduce_by_key adding the values of the runs of keys equal
+   * according to ``pred``
+   */
+  template <class InputIt1, class InputIt2, class OutputIt1, class OutputIt2,
+            class BinaryPredicate>
+  std::pair<OutputIt1, OutputIt2> reduce_by_key(
+      InputIt1 keys_first, InputIt1 keys_last, InputIt2 values_first,
+      OutputIt1 keys_output, OutputIt2 values_output, BinaryPredicate pred) {
+    using value_type = typename std::iterator_traits<InputIt2>::value_type;
+    return reduce_by_key(keys_first, keys_last, values_first, keys_output,
+                         values_output, pred, std::plus<value_type>());
+  }
+
+  /** reduce_by_key
+   * @brief reduce_by_key adding the values of the runs of equal keys
+   */
+  template <class InputIt1, class InputIt2, class OutputIt1, class OutputIt2>
+  std::pair<OutputIt1, OutputIt2> reduce_by_key(
+      InputIt1 keys_first, InputIt1 keys_last, InputIt2 values_first,
+      OutputIt1 keys_output, OutputIt2 values_output) {
+    using key_type = typename std::iterator_traits<InputIt1>::value_type;
+    return reduce_by_key(keys_first, keys_last, values_first, keys_output,
+                         values_output, std::equal_to<key_type>());
+  }
+};
+
+}  // sycl
+
+#endif  // __SYCL_HOST_PARALLEL_EXECUTION_POLICY__
@@ -0,0 +1,655 @@
+/* Copyright (c) 2015-2018 The Khronos Group Inc.
+
+  Permission is hereby granted, free of charge, to any person obtaining a
+  copy of this software and/or associated documentation files (the
+  "Materials"), to deal in the Materials without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Materials, and to
+  permit persons to whom the Materials are furnished to do so, subject to
+  the following conditions:
+
+  The above copyright notice and this permission notice shall be included
+  in all copies or substantial portions of the Materials.
+
+  MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+  KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+  SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+     https://www.khronos.org/registry/
+
+  THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+*/
+
+#ifndef __SYCL_MULTI_DEVICE_EXECUTION_POLICY__
+#define __SYCL_MULTI_DEVICE_EXECUTION_POLICY__
+
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <CL/sycl.hpp>
+#include <sycl/execution_policy>
+#include <sycl/heterogeneous_execution_policy.hpp>
+#include <sycl/helpers/sycl_queue_worker.hpp>
+
+namespace sycl {
+
+namespace impl {
+
+/*
+ * Smallest shard of the sort of sycl_multi_device_execution_policy, smaller
+ * ranges are sorted by the first queue alone
+ */
+constexpr size_t multi_device_min_shard = 1 << 14;
+
+/*
+ * Samples taken from every sorted shard to choose the splitters of the sort
+ * of sycl_multi_device_execution_policy
+ */
+constexpr size_t multi_device_oversampling = 32;
+
+/*
+ * make_temp_device_pointer slots of the sort of
+ * sycl_multi_device_execution_policy: the samples and splits are kept by
+ * the caller for the first queue, the bounds by the thread of each queue
+ */
+constexpr int multi_device_samples_order = 25;
+constexpr int multi_device_splits_order = 26;
+constexpr int multi_device_bounds_order = 27;
+
+/*
+ * Frees a bucket of the sort, which lives until every queue has merged its
+ * own, so that a queue given twice to the policy has two buckets
+ */
+struct usm_deleter {
+  cl::sycl::queue queue;
+
+  void operator()(void *ptr) {
+    // an exception may leave kernels of the queue using it
+    queue.wait();
+    cl::sycl::free(ptr, queue);
+  }
+};
+
+template <class T>
+using usm_unique_ptr = std::unique_ptr<T, usm_deleter>;
+
+/*
+ * Merges the pairs of consecutive sorted runs of input into output: runs 2r
+ * and 2r + 1 become one run, and the last run is copied when their number is
+ * odd. bounds holds the runs + 1 offsets of the runs. Every element is put
+ * at its position in its run plus its rank in the other run of its pair,
+ * the elements of the first run going first on ties.
+ */
+template <class ExecutionPolicy, class T, class Compare>
+void merge_runs(ExecutionPolicy &exec, const T *input, T *output,
+                const size_t *bounds, size_t runs, size_t count,
+                Compare comp) {
+  const auto ndRange = exec.calculateNdRange(count);
+  exec.get_queue().submit([&](cl::sycl::handler &h) {
+    h.parallel_for(ndRange, [=](cl::sycl::nd_item<1> id) {
+      const size_t gid = id.get_global_id(0);
+      if (gid >= count) {
+        return;
+      }
+      size_t r = 0;
+      while (bounds[r + 1] <= gid) {
+        r++;
+      }
+      const T key = input[gid];
+      const size_t other = r ^ 1;
+      if (other >= runs) {
+        output[gid] = key;
+        return;
+      }
+      const bool first_run = (r % 2 == 0);
+      size_t lo = bounds[other];
+      size_t hi = bounds[other + 1];
+      while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const bool before =
+            first_run ? comp(input[mid], key) : !comp(key, input[mid]);
+        lo = before ? mid + 1 : lo;
+        hi = before ? hi : mid;
+      }
+      const size_t pair_begin = bounds[r - r % 2];
+      output[pair_begin + (gid - bounds[r]) + (lo - bounds[other])] = key;
+    });
+  }).wait();
+}
+
+}  // namespace impl
+
+/** class sycl_multi_device_execution_policy.
+* @brief Shards every algorithm across several SYCL queues, e.g. the devices
+* of a node or the sub-devices of a CPU. The range is cut into one shard of
+* equal size per queue, and every queue runs its shard from its own host
+* thread. As for sycl_heterogeneous_execution_policy, the iterators must be
+* USM accessible from every queue.
+* Reductions combine the partial results of the shards in order, so their
+* operation only needs to be associative. Scans first reduce the shards to
+* get the carry each of them starts from, then scan them all at once.
+* sort sorts the shards, chooses splitters among samples of the sorted
+* shards, then every queue gathers the pieces of all the shards falling
+* between two splitters, merges them and writes them back.
+*/
+template <class KernelName>
+class sycl_multi_device_execution_policy
+    : public sycl_execution_policy<KernelName> {
+  using policy_type = sycl_execution_policy<KernelName>;
+
+  std::vector<cl::sycl::queue> m_queues;
+
+  // Size of the shards of a range of n elements
+  size_t shard_size(size_t n) const {
+    return impl::up_rounded_division(n, m_queues.size());
+  }
+
+  /* Runs f(index, policy) for every queue, the first one from the caller
+  * and the others from their worker thread, and waits for all of them
+  */
+  template <class F>
+  void for_queues(F f) {
+    std::vector<std::future<void>> others;
+    for (size_t i = 1; i < m_queues.size(); i++) {
+      auto &worker = sycl::helpers::queue_worker::of(m_queues[i]);
+      others.push_back(worker.run([&, i] {
+        policy_type p(m_queues[i]);
+        f(i, p);
+      }));
+    }
+    sycl::helpers::run_and_join(others, [&] {
+      policy_type p(m_queues[0]);
+      f(0, p);
+    });
+  }
+
+  /* Runs f(index, policy, begin, end) on every non empty shard [begin, end)
+  * of [0, n)
+  */
+  template <class F>
+  void for_shards(size_t n, F f) {
+    const size_t size = shard_size(n);
+    for_queues([&](size_t index, policy_type &p) {
+      const size_t begin = std::min(n, index * size);
+      const size_t end = std::min(n, begin + size);
+      if (begin < end) {
+        f(index, p, begin, end);
+      }
+    });
+  }
+
+  /* Reductions of the shards of [0, n): ``first_shard(p, end)`` reduces
+  * [0, end) with the initial value, ``shard(p, begin, end)`` reduces the
+  * other shards without it. Empty shards have no reduction.
+  */
+  template <class T, class FirstShard, class Shard>
+  std::vector<std::optional<T>> reduce_shards(size_t n, FirstShard first_shard,
+                                              Shard shard) {
+    std::vector<std::optional<T>> partials(m_queues.size());
+    for_shards(n, [&](size_t index, policy_type &p, size_t begin, size_t end) {
+      partials[index] = (index == 0) ? first_shard(p, end)
+                                     : shard(p, begin, end);
+    });
+    return partials;
+  }
+
+  /* Reduction with ``op`` of init and of the elements of [0, n), see
+  * reduce_shards
+  */
+  template <class T, class FirstShard, class Shard, class BinaryOperation>
+  T shard_reduce(size_t n, T init, FirstShard first_shard, Shard shard,
+                 BinaryOperation op) {
+    auto partials = reduce_shards<T>(n, first_shard, shard);
+    if (!partials[0]) {
+      return init;
+    }
+    T res = *partials[0];
+    for (size_t i = 1; i < partials.size(); i++) {
+      if (partials[i]) {
+        res = op(res, *partials[i]);
+      }
+    }
+    return res;
+  }
+
+  /* Initial value of the scan of every shard of [first, first + n): init
+  * for the first one, and the reduction of init and of the previous shards
+  * with ``op`` for the others. The last shard does not need to be reduced.
+  * The carries have the type of the elements, whatever the type of init,
+  * e.g. the int 0 of the scans without an initial value.
+  */
+  template <class InputIterator, class T, class BinaryOperation>
+  std::vector<typename std::iterator_traits<InputIterator>::value_type>
+  shard_carries(InputIterator first, size_t n, T init, BinaryOperation op) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    const size_t last_shard = m_queues.size() - 1;
+    std::vector<std::optional<type_>> partials(m_queues.size());
+    for_shards(n, [&](size_t index, policy_type &p, size_t begin, size_t end) {
+      if (index == last_shard) {
+        return;
+      }
+      const type_ head = impl::read_element(p, first + begin);
+      partials[index] = impl::reduce(p, first + begin + 1, first + end, head, op);
+    });
+    std::vector<type_> carries(m_queues.size(), static_cast<type_>(init));
+    for (size_t i = 1; i < carries.size(); i++) {
+      carries[i] = partials[i - 1] ? op(carries[i - 1], *partials[i - 1])
+                                   : carries[i - 1];
+    }
+    return carries;
+  }
+
+ public:
+  /* Constructs the policy over ``queues``, the first of which is the queue
+  * of the policy
+  */
+  sycl_multi_device_execution_policy(std::vector<cl::sycl::queue> queues)
+      : sycl_execution_policy<KernelName>(queues.at(0)), m_queues(queues) {}
+
+  // Number of queues, and of shards of every range
+  size_t get_nb_queues() const { return m_queues.size(); }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) with a default addition
+   */
+  template <class InputIterator>
+  typename std::iterator_traits<InputIterator>::value_type reduce(
+      InputIterator first, InputIterator last) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return reduce(first, last, type_(0),
+                  [=](type_ v1, type_ v2) { return v1 + v2; });
+  }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) and init with a default
+   * addition
+   */
+  template <class InputIterator, class T>
+  T reduce(InputIterator first, InputIterator last, T init) {
+    return reduce(first, last, init, [=](T v1, T v2) { return v1 + v2; });
+  }
+
+  /** reduce
+   * @brief Reduction of the range [first, last) and init with binop
+   */
+  template <class InputIterator, class T, class BinaryOperation>
+  T reduce(InputIterator first, InputIterator last, T init,
+           BinaryOperation binop) {
+    return shard_reduce(
+        std::distance(first, last), init,
+        [&](policy_type &p, size_t end) {
+          return impl::reduce(p, first, first + end, init, binop);
+        },
+        [&](policy_type &p, size_t begin, size_t end) -> T {
+          const T head = impl::read_element(p, first + begin);
+          return impl::reduce(p, first + begin + 1, first + end, head, binop);
+        },
+        binop);
+  }
+
+  /* transform.
+  * @brief Applies an Unary Operator across the range [b, e).
+  */
+  template <class Iterator, class OutputIterator, class UnaryOperation>
+  OutputIterator transform(Iterator b, Iterator e, OutputIterator out_b,
+                           UnaryOperation op) {
+    const size_t n = std::distance(b, e);
+    for_shards(n, [&](size_t, policy_type &p, size_t begin, size_t end) {
+      impl::transform(p, b + begin, b + end, out_b + begin, op);
+    });
+    return out_b + n;
+  }
+
+  /* transform.
+  * @brief Applies a Binary Operator across the range [first1, last1).
+  */
+  template <class InputIt1, class InputIt2, class OutputIt,
+            class BinaryOperation>
+  OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                     OutputIt result, BinaryOperation binary_op) {
+    const size_t n = std::distance(first1, last1);
+    for_shards(n, [&](size_t, policy_type &p, size_t begin, size_t end) {
+      impl::transform(p, first1 + begin, first1 + end, first2 + begin,
+                      result + begin, binary_op);
+    });
+    return result + n;
+  }
+
+  /* for_each
+   */
+  template <class Iterator, class UnaryFunction>
+  void for_each(Iterator b, Iterator e, UnaryFunction f) {
+    for_shards(std::distance(b, e),
+               [&](size_t, policy_type &p, size_t begin, size_t end) {
+      impl::for_each(p, b + begin, b + end, f);
+    });
+  }
+
+  /* fill.
+  * @brief Assigns value to every element of the range [first, last)
+  */
+  template <class ForwardIt, class T>
+  void fill(ForwardIt first, ForwardIt last, const T &value) {
+    for_shards(std::distance(first, last),
+               [&](size_t, policy_type &p, size_t begin, size_t end) {
+      impl::fill(p, first + begin, first + end, value);
+    });
+  }
+
+  /* transform_reduce.
+  * @brief Reduction with binary_op of init and of unary_op applied to the
+  * elements of the range [first, last)
+  */
+  template <class InputIterator, class UnaryOperation, class T,
+            class BinaryOperation>
+  T transform_reduce(InputIterator first, InputIterator last,
+                     UnaryOperation unary_op, T init,
+                     BinaryOperation binary_op) {
+    return shard_reduce(
+        std::distance(first, last), init,
+        [&](policy_type &p, size_t end) {
+          return impl::transform_reduce(p, first, first + end, unary_op, init,
+                                        binary_op);
+        },
+        [&](policy_type &p, size_t begin, size_t end) -> T {
+          const T head = unary_op(impl::read_element(p, first + begin));
+          return impl::transform_reduce(p, first + begin + 1, first + end,
+                                        unary_op, head, binary_op);
+        },
+        binary_op);
+  }
+
+  /* transform_reduce.
+  * @brief Reduction with binary_op of init and of transform_op applied to
+  * the pairs of elements of the ranges [first1, last1) and first2..
+  */
+  template <class InputIt1, class InputIt2, class T, class BinaryOperation1,
+            class BinaryOperation2>
+  T transform_reduce(InputIt1 first1, InputIt1 last1, InputIt2 first2, T init,
+                     BinaryOperation1 binary_op, BinaryOperation2 transform_op) {
+    return shard_reduce(
+        std::distance(first1, last1), init,
+        [&](policy_type &p, size_t end) {
+          return impl::transform_reduce(p, first1, first1 + end, first2, init,
+                                        binary_op, transform_op);
+        },
+        [&](policy_type &p, size_t begin, size_t end) -> T {
+          const T head = transform_op(impl::read_element(p, first1 + begin),
+                                      impl::read_element(p, first2 + begin));
+          return impl::transform_reduce(p, first1 + begin + 1, first1 + end,
+                                        first2 + begin + 1, head, binary_op,
+                                        transform_op);
+        },
+        binary_op);
+  }
+
+  /* count.
+   * @brief Returns the number of elements in the range ``[first, last)``
+   * that are equal to ``value``.
+   */
+  template <class InputIt, class T>
+  typename std::iterator_traits<InputIt>::difference_type count(
+      InputIt first, InputIt last, T value) {
+    return count_if(first, last, [=](T other) { return value == other; });
+  }
+
+  /* count_if.
+  * @brief Returns the number of elements in the range ``[first, last)`` for
+  * which p is true.
+  */
+  template <class InputIt, class UnaryPredicate>
+  typename std::iterator_traits<InputIt>::difference_type count_if(
+      InputIt first, InputIt last, UnaryPredicate p) {
+    using difference_type =
+        typename std::iterator_traits<InputIt>::difference_type;
+    std::vector<difference_type> counts(m_queues.size(), 0);
+    for_shards(std::distance(first, last),
+               [&](size_t index, policy_type &pol, size_t begin, size_t end) {
+      counts[index] = impl::count_if(pol, first + begin, first + end, p);
+    });
+    return std::accumulate(counts.begin(), counts.end(), difference_type{0});
+  }
+
+  /** exclusive_scan.
+  * @brief Exclusive scan of the range [first, last) with a default addition
+  */
+  template <class InputIterator, class OutputIterator, class T>
+  OutputIterator exclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator output, T init) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return exclusive_scan(first, last, output, init,
+                          [=](type_ v1, type_ v2) { return v1 + v2; });
+  }
+
+  /** exclusive_scan.
+  * @brief Exclusive scan of the range [first, last) with binary_op, every
+  * shard starting from its carry
+  */
+  template <class InputIterator, class OutputIterator, class T,
+            class BinaryOperation>
+  OutputIterator exclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator output, T init,
+                                BinaryOperation binary_op) {
+    const size_t n = std::distance(first, last);
+    const auto carries = shard_carries(first, n, init, binary_op);
+    for_shards(n, [&](size_t index, policy_type &p, size_t begin, size_t end) {
+      impl::exclusive_scan(p, first + begin, first + end, output + begin,
+                           carries[index], binary_op);
+    });
+    return output + n;
+  }
+
+  /** inclusive_scan.
+  * @brief Inclusive scan of the range [first, last) with a default addition
+  */
+  template <class InputIterator, class OutputIterator>
+  OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator d_first) {
+    typedef typename std::iterator_traits<InputIterator>::value_type type_;
+    return inclusive_scan(first, last, d_first,
+                          [=](type_ v1, type_ v2) { return v1 + v2; }, 0);
+  }
+
+  /** inclusive_scan.
+  * @brief Inclusive scan of the range [first, last) with binary_op
+  */
+  template <class InputIterator, class OutputIterator, class BinaryOperation>
+  OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator d_first,
+                                BinaryOperation binary_op) {
+    return inclusive_scan(first, last, d_first, binary_op, 0);
+  }
+
+  /* inclusive_scan.
+  * @brief Inclusive scan of the range [first, last) and init with binary_op,
+  * every shard starting from its carry
+  */
+  template <class InputIterator, class OutputIterator, class BinaryOperation,
+            class T>
+  OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                OutputIterator d_first,
+                                BinaryOperation binary_op, T init) {
+    const size_t n = std::distance(first, last);
+    const auto carries = shard_carries(first, n, init, binary_op);
+    for_shards(n, [&](size_t index, policy_type &p, size_t begin, size_t end) {
+      impl::inclusive_scan(p, first + begin, first + end, d_first + begin,
+                           carries[index], binary_op);
+    });
+    return d_first + n;
+  }
+
+  /** sort
+   * @brief Sorts the range [first, last)
+   */
+  template <class RandomAccessIterator>
+  void sort(RandomAccessIterator b, RandomAccessIterator e) {
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+    sort(b, e, std::less<T>());
+  }
+
+  /** sort
+   * @brief Sorts the range [first, last) with comp by sample sort:
+   * - every queue sorts its shard,
+   * - the first queue gathers regular samples of the sorted shards, and the
+   *   host picks one splitter every impl::multi_device_oversampling of them,
+   * - the first queue finds where each splitter falls in each shard,
+   * - every queue gathers the pieces of the shards between two splitters
+   *   into its own memory and merges them, as they are sorted,
+   * - once all the pieces are gathered, every queue writes its merged
+   *   elements back, after those of the previous queues.
+   */
+  template <class RandomIt, class Compare>
+  void sort(RandomIt first, RandomIt last, Compare comp) {
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+    const size_t n = std::distance(first, last);
+    const size_t nb_queues = m_queues.size();
+    // already sorted, no kernel to launch
+    if (n < 2) {
+      return;
+    }
+    policy_type p0(m_queues[0]);
+    if (nb_queues == 1 || n < nb_queues * impl::multi_device_min_shard) {
+      impl::sort(p0, first, last, comp);
+      return;
+    }
+
+    for_shards(n, [&](size_t, policy_type &p, size_t begin, size_t end) {
+      impl::sort(p, first + begin, first + end, comp);
+    });
+
+    cl::sycl::queue q0 = m_queues[0];
+    const size_t size = shard_size(n);
+    const size_t oversampling = impl::multi_device_oversampling;
+    std::vector<T> samples(nb_queues * oversampling);
+    T *d_samples = sycl::helpers::make_temp_device_pointer<
+        T, impl::multi_device_samples_order>(samples.size(), q0);
+    q0.submit([&](cl::sycl::handler &h) {
+      h.parallel_for(cl::sycl::range<1>(samples.size()),
+                     [=](cl::sycl::id<1> id) {
+        const size_t begin = (id[0] / oversampling) * size;
+        const size_t end = std::min(n, begin + size);
+        d_samples[id[0]] =
+            first[begin + (end - begin) * (id[0] % oversampling) / oversampling];
+      });
+    }).wait();
+    q0.memcpy(samples.data(), d_samples, sizeof(T) * samples.size()).wait();
+    std::sort(samples.begin(), samples.end(), comp);
+
+    // splitters[j] is the first element of the bucket j + 1
+    const size_t nb_splitters = nb_queues - 1;
+    T *d_splitters = d_samples;
+    for (size_t j = 0; j < nb_splitters; j++) {
+      samples[j] = samples[(j + 1) * oversampling];
+    }
+    q0.memcpy(d_splitters, samples.data(), sizeof(T) * nb_splitters).wait();
+
+    // position of the splitter j in the shard k, found by binary search
+    std::vector<size_t> splits(nb_queues * nb_splitters);
+    size_t *d_splits = sycl::helpers::make_temp_device_pointer<
+        size_t, impl::multi_device_splits_order>(splits.size(), q0);
+    q0.submit([&](cl::sycl::handler &h) {
+      h.parallel_for(cl::sycl::range<1>(splits.size()),
+                     [=](cl::sycl::id<1> id) {
+        const size_t begin = (id[0] / nb_splitters) * size;
+        const T splitter = d_splitters[id[0] % nb_splitters];
+        size_t lo = begin;
+        size_t hi = std::min(n, begin + size);
+        while (lo < hi) {
+          const size_t mid = lo + (hi - lo) / 2;
+          const bool before = comp(first[mid], splitter);
+          lo = before ? mid + 1 : lo;
+          hi = before ? hi : mid;
+        }
+        d_splits[id[0]] = lo;
+      });
+    }).wait();
+    q0.memcpy(splits.data(), d_splits, sizeof(size_t) * splits.size()).wait();
+
+    // the piece of the shard k in the bucket j is [cut(k, j), cut(k, j + 1))
+    auto cut = [&](size_t k, size_t j) {
+      if (j == 0) {
+        return std::min(n, k * size);
+      }
+      if (j == nb_queues) {
+        return std::min(n, (k + 1) * size);
+      }
+      return splits[k * nb_splitters + j - 1];
+    };
+    std::vector<size_t> offsets(nb_queues + 1, 0);
+    for (size_t j = 0; j < nb_queues; j++) {
+      offsets[j + 1] = offsets[j];
+      for (size_t k = 0; k < nb_queues; k++) {
+        offsets[j + 1] += cut(k, j + 1) - cut(k, j);
+      }
+    }
+
+    std::vector<impl::usm_unique_ptr<T>> buckets(nb_queues);
+    std::vector<T *> merged(nb_queues, nullptr);
+    for_queues([&](size_t j, policy_type &p) {
+      const size_t count = offsets[j + 1] - offsets[j];
+      if (count == 0) {
+        return;
+      }
+      cl::sycl::queue q = p.get_queue();
+      buckets[j] = impl::usm_unique_ptr<T>(
+          cl::sycl::malloc_device<T>(2 * count, q), impl::usm_deleter{q});
+      if (!buckets[j]) {
+        throw std::bad_alloc();
+      }
+      T *input = buckets[j].get();
+      T *output = input + count;
+      std::vector<size_t> bounds{0};
+      for (size_t k = 0; k < nb_queues; k++) {
+        const size_t begin = cut(k, j);
+        const size_t end = cut(k, j + 1);
+        if (begin < end) {
+          impl::copy(p, first + begin, first + end, input + bounds.back());
+          bounds.push_back(bounds.back() + end - begin);
+        }
+      }
+
+      size_t *d_bounds = sycl::helpers::make_temp_device_pointer<
+          size_t, impl::multi_device_bounds_order>(bounds.size(), q);
+      while (bounds.size() > 2) {
+        q.memcpy(d_bounds, bounds.data(), sizeof(size_t) * bounds.size())
+            .wait();
+        impl::merge_runs(p, input, output, d_bounds, bounds.size() - 1, count,
+                         comp);
+        std::swap(input, output);
+        std::vector<size_t> pairs;
+        for (size_t r = 0; r < bounds.size(); r += 2) {
+          pairs.push_back(bounds[r]);
+        }
+        if (pairs.back() != count) {
+          pairs.push_back(count);
+        }
+        bounds = pairs;
+      }
+      merged[j] = input;
+    });
+
+    for_queues([&](size_t j, policy_type &p) {
+      if (!merged[j]) {
+        return;
+      }
+      const size_t count = offsets[j + 1] - offsets[j];
+      impl::copy(p, merged[j], merged[j] + count, first + offsets[j]);
+    });
+  }
+};
+
+}  // sycl
+
+#endif  // __SYCL_MULTI_DEVICE_EXECUTION_POLICY__
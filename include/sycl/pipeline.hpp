@@ -0,0 +1,345 @@
+/* Copyright (c) 2015-2018 The Khronos Group Inc.
+
+  Permission is hereby granted, free of charge, to any person obtaining a
+  copy of this software and/or associated documentation files (the
+  "Materials"), to deal in the Materials without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell copies of the Materials, and to
+  permit persons to whom the Materials are furnished to do so, subject to
+  the following conditions:
+
+  The above copyright notice and this permission notice shall be included
+  in all copies or substantial portions of the Materials.
+
+  MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+  KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+  SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+     https://www.khronos.org/registry/
+
+  THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+  MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+*/
+
+#ifndef __SYCL_PIPELINE__
+#define __SYCL_PIPELINE__
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <CL/sycl.hpp>
+#include <sycl/helpers/sycl_buffers.hpp>
+#include <sycl/helpers/sycl_differences.hpp>
+#include <sycl/algorithm/buffer_algorithms.hpp>
+#include <sycl/algorithm/exclusive_scan.hpp>
+
+namespace sycl {
+
+namespace impl {
+
+/*
+ * Stage of a pipeline passing ``f(x)`` on
+ */
+template <typename F>
+struct transform_stage {
+  static constexpr bool filters = false;
+
+  template <typename T>
+  using result = std::decay_t<std::invoke_result_t<F, T>>;
+
+  F f;
+
+  template <typename T, typename Next>
+  void operator()(const T &x, Next &&next) const {
+    next(f(x));
+  }
+};
+
+/*
+ * Stage of a pipeline passing on the elements for which ``p(x)`` is true
+ */
+template <typename Predicate>
+struct filter_stage {
+  static constexpr bool filters = true;
+
+  template <typename T>
+  using result = T;
+
+  Predicate p;
+
+  template <typename T, typename Next>
+  void operator()(const T &x, Next &&next) const {
+    if (p(x))
+      next(x);
+  }
+};
+
+/*
+ * Type of the elements of type T once they went through Stages
+ */
+template <typename T, typename... Stages>
+struct pipeline_result {
+  using type = T;
+};
+
+template <typename T, typename Stage, typename... Stages>
+struct pipeline_result<T, Stage, Stages...> {
+  using type = typename pipeline_result<
+    typename Stage::template result<T>, Stages...>::type;
+};
+
+/*
+ * Runs ``x`` through the stages I.. of ``stages``, then calls ``last`` on the
+ * element if no stage filtered it out. Stages call the next one directly, so
+ * the whole chain is inlined into the kernel of the terminal operation.
+ */
+template <size_t I, typename Stages, typename T, typename Last>
+void run_stages(const Stages &stages, const T &x, Last &last) {
+  if constexpr (I == std::tuple_size<Stages>::value) {
+    last(x);
+  } else {
+    std::get<I>(stages)(x, [&](const auto &y) {
+      run_stages<I + 1>(stages, y, last);
+    });
+  }
+}
+
+/*
+ * Accumulator of a reduction over a pipeline which filters elements out,
+ * ``valid`` is false as long as no element was kept
+ */
+template <typename B>
+struct pipeline_accumulator {
+  bool valid;
+  B value;
+};
+
+}  // namespace impl
+
+/** class pipeline.
+* @brief Lazy sequence of element-wise stages over the range [first, last).
+* transform and filter return a new pipeline without running anything; the
+* terminal operations, reduce, inclusive_scan, copy and for_each, run the
+* stages inside their own kernel, so the intermediate values are never
+* written to memory.
+*/
+template <typename Iterator, typename... Stages>
+class pipeline {
+  template <typename, typename...>
+  friend class pipeline;
+
+  using input_type = typename std::iterator_traits<Iterator>::value_type;
+  using stages_type = std::tuple<Stages...>;
+
+  Iterator m_first;
+  Iterator m_last;
+  stages_type m_stages;
+
+  static constexpr bool filters = (false || ... || Stages::filters);
+
+  pipeline(Iterator first, Iterator last, const stages_type &stages)
+      : m_first(first), m_last(last), m_stages(stages) {}
+
+  template <typename Stage>
+  pipeline<Iterator, Stages..., Stage> append(Stage stage) const {
+    return pipeline<Iterator, Stages..., Stage>(
+      m_first, m_last, std::tuple_cat(m_stages, std::make_tuple(stage)));
+  }
+
+ public:
+  // Type of the elements at the end of the pipeline
+  using value_type =
+    typename impl::pipeline_result<input_type, Stages...>::type;
+
+  pipeline(Iterator first, Iterator last) : m_first(first), m_last(last) {}
+
+  /* transform.
+  * @brief Pipeline passing ``f(x)`` on for every element ``x``
+  */
+  template <typename F>
+  pipeline<Iterator, Stages..., impl::transform_stage<F>> transform(F f) const {
+    return append(impl::transform_stage<F>{f});
+  }
+
+  /* filter.
+  * @brief Pipeline keeping the elements ``x`` for which ``p(x)`` is true
+  */
+  template <typename Predicate>
+  pipeline<Iterator, Stages..., impl::filter_stage<Predicate>> filter(
+      Predicate p) const {
+    return append(impl::filter_stage<Predicate>{p});
+  }
+
+  /* reduce.
+  * @brief Reduction with ``bop`` of init and of the elements at the end of
+  * the pipeline
+  */
+  template <class ExecutionPolicy, class T, class BinaryOperation>
+  T reduce(ExecutionPolicy &snp, T init, BinaryOperation bop) const {
+    auto q = snp.get_queue();
+    auto device = q.get_device();
+    size_t size = sycl::helpers::distance(m_first, m_last);
+    if (size == 0)
+      return init;
+    auto stages = m_stages;
+
+    if constexpr (!filters) {
+      auto d = impl::compute_mapreduce_descriptor(device, size, sizeof(T));
+      auto map = [stages](size_t, input_type x) {
+        T r;
+        auto last = [&](const auto &y) { r = y; };
+        impl::run_stages<0>(stages, x, last);
+        return r;
+      };
+      return impl::buffer_mapreduce(snp, q, m_first, init, d, map, bop);
+    } else {
+      using B = impl::pipeline_accumulator<T>;
+      auto d = impl::compute_mapreduce_descriptor(device, size, sizeof(B));
+      auto map = [stages](size_t, input_type x) {
+        B r{false, T{}};
+        auto last = [&](const auto &y) { r = B{true, static_cast<T>(y)}; };
+        impl::run_stages<0>(stages, x, last);
+        return r;
+      };
+      auto reduce = [bop](B a, B b) {
+        if (!a.valid)
+          return b;
+        if (!b.valid)
+          return a;
+        return B{true, bop(a.value, b.value)};
+      };
+      return impl::buffer_mapreduce(snp, q, m_first, B{true, init}, d, map,
+                                    reduce).value;
+    }
+  }
+
+  /* inclusive_scan.
+  * @brief Inclusive scan with ``bop`` of init and of the elements at the end
+  * of the pipeline, written to ``o``.
+  * Pipelines which filter elements out would have to be compacted first, so
+  * they cannot be scanned.
+  */
+  template <class ExecutionPolicy, class OutputIterator, class BinaryOperation,
+            class T>
+  OutputIterator inclusive_scan(ExecutionPolicy &snp, OutputIterator o,
+                                BinaryOperation bop, T init) const {
+    static_assert(!filters, "inclusive_scan of a pipeline with a filter");
+    using B = typename std::iterator_traits<OutputIterator>::value_type;
+    auto q = snp.get_queue();
+    auto device = q.get_device();
+    size_t size = sycl::helpers::distance(m_first, m_last);
+    auto stages = m_stages;
+    auto d = impl::compute_mapscan_descriptor(device, size, sizeof(B));
+    impl::buffer_mapscan(snp, q, m_first, o, static_cast<B>(init), d,
+                         [stages](input_type x) {
+                           B r;
+                           auto last = [&](const auto &y) { r = y; };
+                           impl::run_stages<0>(stages, x, last);
+                           return r;
+                         },
+                         bop);
+    return std::next(o, size);
+  }
+
+  /* for_each.
+  * @brief Calls ``f`` on every element at the end of the pipeline
+  */
+  template <class ExecutionPolicy, class UnaryFunction>
+  void for_each(ExecutionPolicy &snp, UnaryFunction f) const {
+    auto q = snp.get_queue();
+    size_t size = sycl::helpers::distance(m_first, m_last);
+    if (size == 0)
+      return;
+    const auto ndRange = snp.calculateNdRange(size);
+    auto input = m_first;
+    auto stages = m_stages;
+    snp.complete(q.submit([&](cl::sycl::handler &h) {
+      h.parallel_for(ndRange, [=](cl::sycl::nd_item<1> id) {
+        const size_t pos = id.get_global_id(0);
+        if (pos < size) {
+          auto last = [&](const auto &y) { f(y); };
+          impl::run_stages<0>(stages, input[pos], last);
+        }
+      });
+    }));
+  }
+
+  /* copy.
+  * @brief Writes the elements at the end of the pipeline to ``o``, in order,
+  * and returns the end of the written range. When elements are filtered out,
+  * the kept ones are numbered with a scan of their flags, then the stages
+  * run a second time to write them at their position.
+  */
+  template <class ExecutionPolicy, class OutputIterator>
+  OutputIterator copy(ExecutionPolicy &snp, OutputIterator o) const {
+    auto q = snp.get_queue();
+    size_t size = sycl::helpers::distance(m_first, m_last);
+    if (size == 0)
+      return o;
+    const auto ndRange = snp.calculateNdRange(size);
+    auto input = m_first;
+    auto stages = m_stages;
+
+    if constexpr (!filters) {
+      snp.complete(q.submit([&](cl::sycl::handler &h) {
+        h.parallel_for(ndRange, [=](cl::sycl::nd_item<1> id) {
+          const size_t pos = id.get_global_id(0);
+          if (pos < size) {
+            auto last = [&](const auto &y) { o[pos] = y; };
+            impl::run_stages<0>(stages, input[pos], last);
+          }
+        });
+      }));
+      return std::next(o, size);
+    } else {
+      size_t *indices =
+        sycl::helpers::make_temp_device_pointer<size_t, 0>(size, q);
+      q.submit([&](cl::sycl::handler &h) {
+        h.parallel_for(ndRange, [=](cl::sycl::nd_item<1> id) {
+          const size_t pos = id.get_global_id(0);
+          if (pos < size) {
+            size_t kept = 0;
+            auto last = [&](const auto &) { kept = 1; };
+            impl::run_stages<0>(stages, input[pos], last);
+            indices[pos] = kept;
+          }
+        });
+      }).wait();
+
+      size_t count = sycl::helpers::read_device_pointer(indices + size - 1, q);
+      impl::exclusive_scan(snp, indices, indices + size, indices, size_t{0},
+                           std::plus<size_t>());
+      count += sycl::helpers::read_device_pointer(indices + size - 1, q);
+
+      snp.complete(q.submit([&](cl::sycl::handler &h) {
+        h.parallel_for(ndRange, [=](cl::sycl::nd_item<1> id) {
+          const size_t pos = id.get_global_id(0);
+          if (pos < size) {
+            auto last = [&](const auto &y) { o[indices[pos]] = y; };
+            impl::run_stages<0>(stages, input[pos], last);
+          }
+        });
+      }));
+      return std::next(o, count);
+    }
+  }
+};
+
+/* make_pipeline.
+* @brief Pipeline without any stage over the range [first, last)
+*/
+template <typename Iterator>
+pipeline<Iterator> make_pipeline(Iterator first, Iterator last) {
+  return pipeline<Iterator>(first, last);
+}
+
+}  // sycl
+
+#endif  // __SYCL_PIPELINE__
@@ -0,0 +1,66 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <sycl/execution_policy>
+#include <sycl/async_execution_policy.hpp>
+#include <experimental/algorithm>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+namespace parallel = std::experimental::parallel;
+
+struct AsyncExecutionPolicy : public testing::Test {};
+
+// a chain of algorithms enqueued without waiting between them
+TEST_F(AsyncExecutionPolicy, TestSyclAsyncChain) {
+  const size_t size = 10000;
+  sycl::helpers::usm_vector<int> v(size), w(size);
+
+  cl::sycl::queue q;
+  sycl::sycl_async_execution_policy<class AsyncChain> snp(q);
+  parallel::fill(snp, v.begin(), v.end(), 2);
+  parallel::transform(snp, v.begin(), v.end(), w.begin(),
+                      [](int x) { return x * 3; });
+  parallel::for_each(snp, w.begin(), w.end(), [](int &x) { x += 1; });
+  parallel::reverse(snp, w.begin(), w.end());
+  snp.wait();
+
+  EXPECT_TRUE(std::all_of(w.begin(), w.end(), [](int x) { return x == 7; }));
+}
+
+// values read back by the blocking algorithms see the enqueued ones
+TEST_F(AsyncExecutionPolicy, TestSyclAsyncThenReduce) {
+  const size_t size = 4096;
+  sycl::helpers::usm_vector<int> v(size);
+
+  cl::sycl::queue q;
+  sycl::sycl_async_execution_policy<class AsyncThenReduce> snp(q);
+  parallel::fill(snp, v.begin(), v.end(), 1);
+  int res = parallel::reduce(snp, v.begin(), v.end(), 0);
+
+  EXPECT_EQ(int(size), res);
+}
+
+TEST_F(AsyncExecutionPolicy, TestSyclAsyncEvents) {
+  const size_t size = 1000;
+  sycl::helpers::usm_vector<int> v(size);
+  std::iota(v.begin(), v.end(), 0);
+
+  cl::sycl::queue other_q;
+  auto data = v.data();
+  auto e = other_q.parallel_for(cl::sycl::range<1>(size),
+                                [=](cl::sycl::id<1> i) { data[i] *= 2; });
+
+  cl::sycl::queue q;
+  sycl::sycl_async_execution_policy<class AsyncEvents> snp(q);
+  snp.depends_on(e);
+  parallel::for_each(snp, v.begin(), v.end(), [](int &x) { x += 1; });
+  snp.get_event().wait();
+
+  for (size_t i = 0; i < size; i++) {
+    EXPECT_EQ(int(2 * i + 1), v[i]);
+  }
+}
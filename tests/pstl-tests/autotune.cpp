@@ -0,0 +1,50 @@
+#include "gmock/gmock.h"
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <string>
+
+#include <sycl/execution_policy>
+#include <experimental/algorithm>
+#include <sycl/helpers/sycl_tuning_cache.hpp>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+namespace parallel = std::experimental::parallel;
+
+struct AutotuneAlgorithm : public testing::Test {};
+
+TEST_F(AutotuneAlgorithm, TestSyclAutotuneReduce) {
+  const std::string path = "autotune_test_tuning.txt";
+  std::remove(path.c_str());
+  auto &cache = sycl::helpers::tuning_cache::instance();
+  cache.set_file(path);
+  cache.set_mode(sycl::helpers::tuning_cache::mode::on);
+
+  const int n = 100003;
+  sycl::helpers::usm_vector<int> v(n);
+  std::iota(v.begin(), v.end(), -n / 2);
+  const int expected = std::accumulate(v.begin(), v.end(), 3);
+
+  sycl::sycl_execution_policy<class AutotuneReduce> snp;
+  // tuned on the first call, then read from the cache
+  EXPECT_EQ(expected, parallel::reduce(snp, v.begin(), v.end(), 3,
+                                       std::plus<int>()));
+  EXPECT_EQ(expected, parallel::reduce(snp, v.begin(), v.end(), 3,
+                                       std::plus<int>()));
+
+  if (cache.get_mode() == sycl::helpers::tuning_cache::mode::off) {
+    // disabled from the environment
+    return;
+  }
+  std::ifstream file(path);
+  std::string line;
+  ASSERT_TRUE(std::getline(file, line).good());
+  // algorithm, size of the accumulator, device, size bucket and launch
+  EXPECT_EQ(5, std::count(line.begin(), line.end(), '\t'));
+
+  cache.set_mode(sycl::helpers::tuning_cache::mode::off);
+  std::remove(path.c_str());
+}
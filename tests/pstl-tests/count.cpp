@@ -58,3 +58,17 @@ TEST_F(CountAlgorithm, TestSyclCount) {
 
   EXPECT_TRUE(res_std == res_sycl);
 }
+
+// more matches than the element type can count
+TEST_F(CountAlgorithm, TestSyclCountChar) {
+  sycl::helpers::usm_vector<char> v(1000, 'a');
+  v[10] = 'b';
+
+  auto res_std = std::count(begin(v), end(v), 'a');
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class CountAlgorithmChar> snp(q);
+  auto res_sycl = parallel::count(snp, begin(v), end(v), 'a');
+
+  EXPECT_EQ(res_std, res_sycl);
+}
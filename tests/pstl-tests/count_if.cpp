@@ -62,3 +62,40 @@ TEST_F(CountIfAlgorithm, TestSyclCountIf) {
 
   EXPECT_TRUE(res_std == res_sycl);
 }
+
+// size not a multiple of the block read by each work item
+TEST_F(CountIfAlgorithm, TestSyclCountIfLarge) {
+  sycl::helpers::usm_vector<int> v(100003);
+  for (auto& x : v) {
+    x = std::rand() % 3;
+  }
+
+  auto predicate = [=](int x) { return x == 0; };
+
+  auto res_std = std::count_if(v.begin(), v.end(), predicate);
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class CountIfAlgorithmLarge> snp(q);
+  auto res_sycl = count_if(snp, v.begin(), v.end(), predicate);
+
+  EXPECT_EQ(res_std, res_sycl);
+}
+
+// the counts added by a given operation, as on devices without 64-bit atomics
+TEST_F(CountIfAlgorithm, TestSyclCountIfBinaryOp) {
+  sycl::helpers::usm_vector<int> v(100003);
+  for (auto& x : v) {
+    x = std::rand() % 3;
+  }
+
+  auto predicate = [=](int x) { return x == 0; };
+
+  auto res_std = std::count_if(v.begin(), v.end(), predicate);
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class CountIfAlgorithmBinaryOp> snp(q);
+  auto res_sycl = sycl::impl::count_if(snp, v.begin(), v.end(), predicate,
+                                       [](long x, long y) { return x + y; });
+
+  EXPECT_EQ(res_std, res_sycl);
+}
@@ -0,0 +1,83 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include <sycl/execution_policy>
+#include <sycl/dynamic_execution_policy.hpp>
+#include <experimental/algorithm>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+#include "multi_queue_helpers.hpp"
+
+namespace parallel = std::experimental::parallel;
+
+struct DynamicExecutionPolicy : public testing::Test {};
+
+TEST_F(DynamicExecutionPolicy, TestSyclDynamicElementWise) {
+  const size_t size = 300001;
+  sycl::helpers::usm_vector<int> v(size), w(size);
+
+  sycl::sycl_dynamic_execution_policy<class DynamicElementWise> snp(
+      make_queues(3));
+  parallel::fill(snp, v.begin(), v.end(), 2);
+  parallel::transform(snp, v.begin(), v.end(), w.begin(),
+                      [](int x) { return x * 3; });
+  parallel::for_each(snp, w.begin(), w.end(), [](int &x) { x += 1; });
+
+  EXPECT_TRUE(std::all_of(w.begin(), w.end(), [](int x) { return x == 7; }));
+}
+
+TEST_F(DynamicExecutionPolicy, TestSyclDynamicReductions) {
+  const size_t size = 300001;
+  sycl::helpers::usm_vector<int> v(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 100; });
+
+  const long sum = std::accumulate(v.begin(), v.end(), 5l);
+  const auto odd = std::count_if(v.begin(), v.end(),
+                                 [](int x) { return x % 2 == 1; });
+
+  sycl::sycl_dynamic_execution_policy<class DynamicReductions> snp(
+      make_queues(2), 4);
+  EXPECT_EQ(sum, parallel::reduce(snp, v.begin(), v.end(), 5l,
+                                  [](long a, long b) { return a + b; }));
+  EXPECT_EQ(2 * (sum - 5) + 5,
+            snp.transform_reduce(v.begin(), v.end(),
+                                 [](int x) { return 2l * x; }, 5l,
+                                 [](long a, long b) { return a + b; }));
+  EXPECT_EQ(odd, snp.count_if(v.begin(), v.end(),
+                              [](int x) { return x % 2 == 1; }));
+}
+
+TEST_F(DynamicExecutionPolicy, TestSyclDynamicEmpty) {
+  sycl::helpers::usm_vector<int> v(1, 4);
+
+  sycl::sycl_dynamic_execution_policy<class DynamicEmpty> snp(make_queues(3));
+  parallel::fill(snp, v.begin(), v.begin(), 2);
+  EXPECT_EQ(4, v[0]);
+  EXPECT_EQ(5, parallel::reduce(snp, v.begin(), v.begin(), 5,
+                                [](int a, int b) { return a + b; }));
+  EXPECT_EQ(0, snp.count_if(v.begin(), v.begin(),
+                            [](int x) { return x % 2 == 0; }));
+}
+
+// below a chunk the first queue runs alone, above it all the queues do
+TEST_F(DynamicExecutionPolicy, TestSyclDynamicFloat) {
+  for (size_t size : {size_t{1000}, size_t{300001}}) {
+    sycl::helpers::usm_vector<float> v(size);
+    fill_quarters(v);
+    const float sum = std::accumulate(v.begin(), v.end(), 0.5f);
+
+    sycl::sycl_dynamic_execution_policy<class DynamicFloat> snp(
+        make_queues(3));
+    EXPECT_EQ(sum, parallel::reduce(snp, v.begin(), v.end(), 0.5f,
+                                    [](float a, float b) { return a + b; }));
+    EXPECT_EQ(2 * (sum - 0.5f),
+              snp.transform_reduce(v.begin(), v.end(),
+                                   [](float x) { return 2 * x; }, 0.0f,
+                                   [](float a, float b) { return a + b; }));
+  }
+}
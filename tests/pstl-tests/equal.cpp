@@ -153,3 +153,25 @@ TEST_F(EqualAlgorithm, NotEqualFloat) {
 
   EXPECT_EQ(result, expected);
 }
+
+TEST_F(EqualAlgorithm, LongEqualToDefault) {
+  const size_t N = 100001;
+  sycl::helpers::usm_vector<int> input1(N);
+  sycl::helpers::usm_vector<int> input2(N);
+  for (size_t i = 0; i < N; i++) {
+    input1[i] = input2[i] = static_cast<int>(i);
+  }
+
+  sycl::sycl_execution_policy<class EqualAlgorithmLongEqualToDefault> snp;
+  EXPECT_TRUE(parallel::equal(snp, begin(input1), end(input1), begin(input2),
+                              end(input2)));
+
+  input2[N - 1] = -1;
+  EXPECT_FALSE(parallel::equal(snp, begin(input1), end(input1), begin(input2),
+                               end(input2)));
+
+  input2[N - 1] = input1[N - 1];
+  input2[3] = -1;
+  EXPECT_FALSE(parallel::equal(snp, begin(input1), end(input1), begin(input2),
+                               end(input2)));
+}
@@ -220,3 +220,18 @@ TEST_F(ExclusiveScanAlgorithm, TestSyclExclusiveScanNonPowerOfTwoRange) {
     EXPECT_TRUE(std::equal(v.begin(), v.end(), gold.begin()));
   }
 }
+
+// in-place scan of distinct values spanning several work-groups
+TEST_F(ExclusiveScanAlgorithm, TestSyclExclusiveScanInPlaceLarge) {
+  sycl::helpers::usm_vector<int> v(10000);
+  std::iota(v.begin(), v.end(), 1);
+  sycl::helpers::usm_vector<int> gold(v);
+
+  exclusive_scan_gold(gold, 3, std::plus());
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class ExclusiveScanAlgorithmInPlace> snp(q);
+  exclusive_scan(snp, v.begin(), v.end(), v.begin(), 3, std::plus());
+
+  EXPECT_TRUE(std::equal(v.begin(), v.end(), gold.begin()));
+}
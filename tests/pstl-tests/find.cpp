@@ -216,3 +216,25 @@ TEST_F(FindAlgorithm, TestSyclFindNotFound) {
   EXPECT_EQ(res_sycl, res_std);
 }
 
+
+TEST_F(FindAlgorithm, TestSyclFindLong) {
+  const size_t size = 1 << 20;
+  sycl::helpers::usm_vector<int> v(size, 0);
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class FindLongAlgorithm> snp(q);
+
+  // no match
+  EXPECT_TRUE(end(v) == parallel::find(snp, begin(v), end(v), 1));
+
+  // several matches, the first one must be returned wherever it is
+  for (size_t first_match : {size_t{0}, size_t{4097}, size - 1}) {
+    std::fill(begin(v), end(v), 0);
+    v[first_match] = 1;
+    if (first_match + 100 < size) {
+      v[first_match + 100] = 1;
+    }
+    v[size - 1] = 1;
+    auto res_sycl = parallel::find(snp, begin(v), end(v), 1);
+    EXPECT_EQ(first_match, size_t(res_sycl - begin(v)));
+  }
+}
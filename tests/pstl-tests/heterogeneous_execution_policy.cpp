@@ -0,0 +1,157 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include <sycl/execution_policy>
+#include <sycl/heterogeneous_execution_policy.hpp>
+#include <experimental/algorithm>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+#include "multi_queue_helpers.hpp"
+
+namespace parallel = std::experimental::parallel;
+
+struct HeterogeneousExecutionPolicy : public testing::Test {};
+
+TEST_F(HeterogeneousExecutionPolicy, TestSyclHeterogeneousElementWise) {
+  const size_t size = 10001;
+  sycl::helpers::usm_vector<int> v(size), w(size);
+
+  for (float ratio : {0.0f, 0.3f, 1.0f}) {
+    sycl::sycl_heterogeneous_execution_policy<class HeterogeneousElementWise>
+        snp(make_queue(), make_queue(), ratio);
+    parallel::fill(snp, v.begin(), v.end(), 2);
+    parallel::transform(snp, v.begin(), v.end(), w.begin(),
+                        [](int x) { return x * 3; });
+    parallel::for_each(snp, w.begin(), w.end(), [](int &x) { x += 1; });
+
+    EXPECT_TRUE(std::all_of(w.begin(), w.end(), [](int x) { return x == 7; }));
+  }
+}
+
+TEST_F(HeterogeneousExecutionPolicy, TestSyclHeterogeneousReductions) {
+  const size_t size = 10001;
+  sycl::helpers::usm_vector<int> v(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 100; });
+
+  const int sum = std::accumulate(v.begin(), v.end(), 5);
+  const auto odd = std::count_if(v.begin(), v.end(),
+                                 [](int x) { return x % 2 == 1; });
+
+  for (float ratio : {0.0f, 0.5f, 0.9f, 1.0f}) {
+    sycl::sycl_heterogeneous_execution_policy<class HeterogeneousReductions>
+        snp(make_queue(), make_queue(), ratio);
+    EXPECT_EQ(sum, parallel::reduce(snp, v.begin(), v.end(), 5,
+                                    [](int a, int b) { return a + b; }));
+    EXPECT_EQ(2 * (sum - 5) + 5,
+              snp.transform_reduce(v.begin(), v.end(),
+                                   [](int x) { return 2 * x; }, 5,
+                                   [](int a, int b) { return a + b; }));
+    EXPECT_EQ(odd, snp.count_if(v.begin(), v.end(),
+                                [](int x) { return x % 2 == 1; }));
+  }
+}
+
+// neither part runs on an empty range
+TEST_F(HeterogeneousExecutionPolicy, TestSyclHeterogeneousEmpty) {
+  sycl::helpers::usm_vector<int> v(1, 4);
+
+  for (float ratio : {0.0f, 0.5f, 1.0f}) {
+    sycl::sycl_heterogeneous_execution_policy<class HeterogeneousEmpty> snp(
+        make_queue(), make_queue(), ratio);
+    EXPECT_EQ(5, parallel::reduce(snp, v.begin(), v.begin(), 5,
+                                  [](int a, int b) { return a + b; }));
+    EXPECT_EQ(5, snp.transform_reduce(v.begin(), v.begin(),
+                                      [](int x) { return 2 * x; }, 5,
+                                      [](int a, int b) { return a + b; }));
+    EXPECT_EQ(0, snp.count(v.begin(), v.begin(), 4));
+    EXPECT_EQ(0, snp.count_if(v.begin(), v.begin(),
+                              [](int x) { return x % 2 == 0; }));
+  }
+}
+
+TEST_F(HeterogeneousExecutionPolicy, TestSyclHeterogeneousScans) {
+  const size_t size = 10001;
+  sycl::helpers::usm_vector<int> v(size), res(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 100; });
+
+  std::vector<int> inclusive(size), exclusive(size);
+  int acc = 3;
+  for (size_t i = 0; i < size; i++) {
+    exclusive[i] = acc;
+    acc += v[i];
+    inclusive[i] = acc;
+  }
+
+  sycl::sycl_heterogeneous_execution_policy<class HeterogeneousScans> snp(
+      make_queue(), make_queue(), 0.4f);
+  snp.inclusive_scan(v.begin(), v.end(), res.begin(),
+                     [](int a, int b) { return a + b; }, 3);
+  EXPECT_TRUE(std::equal(inclusive.begin(), inclusive.end(), res.begin()));
+
+  snp.exclusive_scan(v.begin(), v.end(), res.begin(), 3,
+                     [](int a, int b) { return a + b; });
+  EXPECT_TRUE(std::equal(exclusive.begin(), exclusive.end(), res.begin()));
+}
+
+// the overloads without init start from an int 0, the carry must stay float
+TEST_F(HeterogeneousExecutionPolicy, TestSyclHeterogeneousFloatScan) {
+  const size_t size = 10001;
+  sycl::helpers::usm_vector<float> v(size), res(size);
+  fill_quarters(v);
+  std::vector<float> gold(size);
+  std::partial_sum(v.begin(), v.end(), gold.begin());
+
+  for (float ratio : {0.3f, 0.7f}) {
+    sycl::sycl_heterogeneous_execution_policy<class HeterogeneousFloatScan>
+        snp(make_queue(), make_queue(), ratio);
+    snp.inclusive_scan(v.begin(), v.end(), res.begin());
+    EXPECT_TRUE(std::equal(gold.begin(), gold.end(), res.begin()));
+
+    std::fill(res.begin(), res.end(), 0.0f);
+    snp.inclusive_scan(v.begin(), v.end(), res.begin(),
+                       [](float a, float b) { return a + b; });
+    EXPECT_TRUE(std::equal(gold.begin(), gold.end(), res.begin()));
+  }
+}
+
+TEST_F(HeterogeneousExecutionPolicy, TestSyclHeterogeneousSort) {
+  const size_t size = 3000;
+  for (float ratio : {0.25f, 0.5f, 0.8f}) {
+    sycl::helpers::usm_vector<int> v(size);
+    std::generate(v.begin(), v.end(), [] { return std::rand() % 1000; });
+    std::vector<int> gold(v.begin(), v.end());
+    std::sort(gold.begin(), gold.end());
+
+    sycl::sycl_heterogeneous_execution_policy<class HeterogeneousSort> snp(
+        make_queue(), make_queue(), ratio);
+    snp.sort(v.begin(), v.end());
+
+    EXPECT_TRUE(std::equal(gold.begin(), gold.end(), v.begin()));
+  }
+}
+
+// without a ratio, the split follows the measured throughputs
+TEST_F(HeterogeneousExecutionPolicy, TestSyclHeterogeneousCalibrated) {
+  const size_t size = 100000;
+  sycl::helpers::usm_vector<int> v(size), res(size);
+  std::iota(v.begin(), v.end(), 0);
+
+  sycl::sycl_heterogeneous_execution_policy<class HeterogeneousCalibrated> snp(
+      make_queue(), make_queue());
+  EXPECT_EQ(0.5f, snp.get_ratio("transform"));
+  for (int i = 0; i < 5; i++) {
+    snp.transform(v.begin(), v.end(), res.begin(),
+                  [=](int x) { return x + i; });
+    for (size_t j = 0; j < size; j++) {
+      ASSERT_EQ(int(j) + i, res[j]);
+    }
+    const float ratio = snp.get_ratio("transform");
+    EXPECT_GE(ratio, 0.05f);
+    EXPECT_LE(ratio, 0.95f);
+  }
+}
@@ -0,0 +1,125 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+#include <sycl/execution_policy>
+#include <sycl/algorithm/histogram.hpp>
+#include <ZipIterator.hpp>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+struct HistogramAlgorithm : public testing::Test {};
+
+TEST_F(HistogramAlgorithm, TestSyclHistogramEven) {
+  const size_t N = 100003, nbins = 37;
+  sycl::helpers::usm_vector<int> v(N);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 1200 - 100; });
+  sycl::helpers::usm_vector<unsigned int> bins(nbins, 42);
+
+  sycl::sycl_execution_policy<class HistogramEven> snp;
+  auto bins_end = sycl::impl::histogram_even(snp, v.begin(), v.end(),
+                                             bins.begin(), nbins, 0, 1000);
+
+  std::vector<unsigned int> expected(nbins, 0);
+  for (int x : v) {
+    if (0 <= x && x < 1000)
+      expected[static_cast<size_t>(x) * nbins / 1000]++;
+  }
+  EXPECT_EQ(bins.end(), bins_end);
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bins.begin()));
+}
+
+TEST_F(HistogramAlgorithm, TestSyclHistogramEvenFloat) {
+  sycl::helpers::usm_vector<float> v{0.0f, 0.1f, 0.24f, 0.25f, 0.5f, 0.99f,
+                                     1.0f, -0.1f};
+  sycl::helpers::usm_vector<size_t> bins(4);
+
+  sycl::sycl_execution_policy<class HistogramEvenFloat> snp;
+  sycl::impl::histogram_even(snp, v.begin(), v.end(), bins.begin(), 4, 0.0f,
+                             1.0f);
+
+  std::vector<size_t> expected{3, 1, 1, 1};
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bins.begin()));
+}
+
+TEST_F(HistogramAlgorithm, TestSyclHistogramRange) {
+  const size_t N = 50001;
+  sycl::helpers::usm_vector<float> v(N);
+  std::generate(v.begin(), v.end(),
+                [] { return static_cast<float>(std::rand() % 2000) / 10; });
+  sycl::helpers::usm_vector<float> levels{1.0f, 2.0f, 4.0f, 8.0f, 16.0f,
+                                          32.0f, 64.0f, 128.0f};
+  const size_t nbins = levels.size() - 1;
+  sycl::helpers::usm_vector<int> bins(nbins);
+
+  sycl::sycl_execution_policy<class HistogramRange> snp;
+  sycl::impl::histogram_range(snp, v.begin(), v.end(), bins.begin(), nbins,
+                              levels.begin());
+
+  std::vector<int> expected(nbins, 0);
+  for (float x : v) {
+    auto it = std::upper_bound(levels.begin(), levels.end(), x);
+    if (it != levels.begin() && it != levels.end())
+      expected[it - levels.begin() - 1]++;
+  }
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bins.begin()));
+}
+
+TEST_F(HistogramAlgorithm, TestSyclHistogramEvenLarge) {
+  // too many bins for local memory, counted in global memory directly
+  const size_t N = 20000, nbins = 100000;
+  sycl::helpers::usm_vector<unsigned int> v(N);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % nbins; });
+  sycl::helpers::usm_vector<unsigned int> bins(nbins, 1);
+
+  sycl::sycl_execution_policy<class HistogramEvenLarge> snp;
+  sycl::impl::histogram_even(snp, v.begin(), v.end(), bins.begin(), nbins,
+                             0u, static_cast<unsigned int>(nbins));
+
+  std::vector<unsigned int> expected(nbins, 0);
+  for (unsigned int x : v) {
+    expected[x]++;
+  }
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bins.begin()));
+}
+
+TEST_F(HistogramAlgorithm, TestSyclMultiHistogram) {
+  const size_t N = 30011;
+  sycl::helpers::usm_vector<int> red(N), green(N), blue(N);
+  std::generate(red.begin(), red.end(), [] { return std::rand() % 256; });
+  std::generate(green.begin(), green.end(), [] { return std::rand() % 256; });
+  std::generate(blue.begin(), blue.end(), [] { return std::rand() % 256; });
+  const std::array<size_t, 3> nbins{16, 8, 4};
+  sycl::helpers::usm_vector<int> bins(16 + 8 + 4);
+  const std::array<int *, 3> channel_bins{&bins[0], &bins[16], &bins[24]};
+
+  sycl::sycl_execution_policy<class MultiHistogramEven> snp;
+  sycl::impl::multi_histogram_even(
+      snp, ZipIter(red.begin(), green.begin(), blue.begin()),
+      ZipIter(red.end(), green.end(), blue.end()), channel_bins, nbins,
+      std::array<int, 3>{0, 0, 0}, std::array<int, 3>{256, 256, 256});
+
+  std::vector<int> expected(16 + 8 + 4, 0);
+  for (size_t i = 0; i < N; i++) {
+    expected[red[i] / 16]++;
+    expected[16 + green[i] / 32]++;
+    expected[24 + blue[i] / 64]++;
+  }
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bins.begin()));
+
+  // the same with edges
+  sycl::helpers::usm_vector<int> levels16(17), levels8(9), levels4(5);
+  for (int i = 0; i <= 16; i++) levels16[i] = i * 16;
+  for (int i = 0; i <= 8; i++) levels8[i] = i * 32;
+  for (int i = 0; i <= 4; i++) levels4[i] = i * 64;
+  std::fill(bins.begin(), bins.end(), -1);
+
+  sycl::impl::multi_histogram_range(
+      snp, ZipIter(red.begin(), green.begin(), blue.begin()),
+      ZipIter(red.end(), green.end(), blue.end()), channel_bins, nbins,
+      std::array<int *, 3>{&levels16[0], &levels8[0], &levels4[0]});
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bins.begin()));
+}
@@ -0,0 +1,86 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include <sycl/execution_policy>
+#include <experimental/algorithm>
+#include <sycl/helpers/sycl_host_thresholds.hpp>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+namespace parallel = std::experimental::parallel;
+
+struct HostFastPath : public testing::Test {};
+
+TEST_F(HostFastPath, TestSyclHostThresholds) {
+  auto &thresholds = sycl::helpers::host_thresholds::instance();
+  cl::sycl::queue q;
+  // off unless enabled
+  EXPECT_EQ(0u, thresholds.get_threshold("reduce", q));
+
+  thresholds.calibrate_default_threshold();
+  for (const char *algorithm :
+       {"reduce", "transform", "inclusive_scan", "sort"}) {
+    EXPECT_LE(thresholds.get_threshold(algorithm, q),
+              sycl::helpers::host_thresholds::max_calibrated);
+  }
+  thresholds.set_default_threshold(0);
+
+  thresholds.set_threshold("reduce", 1000);
+  EXPECT_EQ(1000u, thresholds.get_threshold("reduce", q));
+}
+
+// the same results below and above the threshold
+TEST_F(HostFastPath, TestSyclHostSmallInputs) {
+  auto &thresholds = sycl::helpers::host_thresholds::instance();
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class HostSmallInputs> snp(q);
+
+  for (size_t threshold : {size_t{0}, size_t{1000}}) {
+    for (const char *algorithm :
+         {"transform_reduce", "inclusive_scan", "sort", "count_if"}) {
+      thresholds.set_threshold(algorithm, threshold);
+    }
+
+    const size_t size = 500;
+    sycl::helpers::usm_vector<int> v(size), res(size);
+    std::iota(v.begin(), v.end(), 0);
+
+    EXPECT_EQ(int(size * (size - 1)),
+              parallel::transform_reduce(snp, v.begin(), v.end(),
+                                         [](int x) { return 2 * x; }, 0,
+                                         std::plus<int>()));
+
+    parallel::inclusive_scan(snp, v.begin(), v.end(), res.begin(),
+                             std::plus<int>(), 1);
+    for (size_t i = 0; i < size; i++) {
+      EXPECT_EQ(int(i * (i + 1) / 2 + 1), res[i]);
+    }
+
+    std::reverse(v.begin(), v.end());
+    parallel::sort(snp, v.begin(), v.end());
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+
+    EXPECT_EQ(250, parallel::count_if(snp, v.begin(), v.end(),
+                                      [](int x) { return x % 2 == 0; }));
+  }
+}
+
+// device allocations stay on the device whatever their size
+TEST_F(HostFastPath, TestSyclHostDeviceMemory) {
+  const size_t size = 100;
+  sycl::helpers::host_thresholds::instance().set_threshold("fill", 1000);
+  cl::sycl::queue q;
+  int *data = cl::sycl::malloc_device<int>(size, q);
+
+  sycl::sycl_execution_policy<class HostDeviceMemory> snp(q);
+  parallel::fill(snp, data, data + size, 7);
+  std::vector<int> v(size);
+  q.memcpy(v.data(), data, size * sizeof(int)).wait();
+  cl::sycl::free(data, q);
+
+  EXPECT_TRUE(std::all_of(v.begin(), v.end(), [](int x) { return x == 7; }));
+}
@@ -0,0 +1,125 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include <sycl/host_parallel_execution_policy.hpp>
+#include <experimental/algorithm>
+
+namespace parallel = std::experimental::parallel;
+
+struct HostParallelExecutionPolicy : public testing::Test {};
+
+// several blocks per thread, the last one partial
+static const size_t size = 300001;
+
+TEST_F(HostParallelExecutionPolicy, TestHostElementWise) {
+  std::vector<int> v(size), w(size);
+  sycl::helpers::host_thread_pool pool(4);
+  sycl::host_parallel_execution_policy hp(pool);
+
+  parallel::fill(hp, v.begin(), v.end(), 2);
+  parallel::transform(hp, v.begin(), v.end(), w.begin(),
+                      [](int x) { return x * 3; });
+  parallel::for_each(hp, w.begin(), w.end(), [](int &x) { x += 1; });
+  EXPECT_TRUE(std::all_of(w.begin(), w.end(), [](int x) { return x == 7; }));
+
+  std::iota(v.begin(), v.end(), 0);
+  parallel::reverse(hp, v.begin(), v.end());
+  for (size_t i = 0; i < size; i++) {
+    ASSERT_EQ(int(size - 1 - i), v[i]);
+  }
+}
+
+TEST_F(HostParallelExecutionPolicy, TestHostReductions) {
+  std::vector<long> v(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 100; });
+  sycl::host_parallel_execution_policy hp;
+
+  EXPECT_EQ(std::accumulate(v.begin(), v.end(), 5l),
+            parallel::reduce(hp, v.begin(), v.end(), 5l));
+  EXPECT_EQ(std::count_if(v.begin(), v.end(), [](long x) { return x < 10; }),
+            parallel::count_if(hp, v.begin(), v.end(),
+                               [](long x) { return x < 10; }));
+  EXPECT_EQ(std::inner_product(v.begin(), v.end(), v.begin(), 0l),
+            parallel::inner_product(hp, v.begin(), v.end(), v.begin(), 0l));
+
+  const auto minmax = std::minmax_element(v.begin(), v.end());
+  EXPECT_EQ(minmax, parallel::minmax_element(hp, v.begin(), v.end()));
+  EXPECT_EQ(std::find(v.begin(), v.end(), 42l),
+            parallel::find(hp, v.begin(), v.end(), 42l));
+}
+
+TEST_F(HostParallelExecutionPolicy, TestHostScans) {
+  std::vector<int> v(size), res(size), gold(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 10; });
+  sycl::host_parallel_execution_policy hp;
+
+  std::inclusive_scan(v.begin(), v.end(), gold.begin(), std::plus<int>(), 3);
+  parallel::inclusive_scan(hp, v.begin(), v.end(), res.begin(),
+                           std::plus<int>(), 3);
+  EXPECT_EQ(gold, res);
+
+  std::exclusive_scan(v.begin(), v.end(), gold.begin(), 3);
+  parallel::exclusive_scan(hp, v.begin(), v.end(), v.begin(), 3);
+  EXPECT_EQ(gold, v);
+}
+
+TEST_F(HostParallelExecutionPolicy, TestHostSort) {
+  std::vector<int> v(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 1000; });
+  std::vector<int> gold(v);
+  std::sort(gold.begin(), gold.end(), std::greater<int>());
+
+  sycl::host_parallel_execution_policy hp;
+  parallel::sort(hp, v.begin(), v.end(), std::greater<int>());
+  EXPECT_EQ(gold, v);
+}
+
+TEST_F(HostParallelExecutionPolicy, TestHostCompaction) {
+  std::vector<int> v(size), res(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 100; });
+  std::vector<int> gold;
+  std::copy_if(v.begin(), v.end(), std::back_inserter(gold),
+               [](int x) { return x % 3 == 0; });
+
+  sycl::host_parallel_execution_policy hp;
+  auto end = hp.copy_if(v.begin(), v.end(), res.begin(),
+                        [](int x) { return x % 3 == 0; });
+  EXPECT_TRUE(std::equal(gold.begin(), gold.end(), res.begin(), end));
+
+  end = parallel::remove_if(hp, v.begin(), v.end(),
+                            [](int x) { return x % 3 != 0; });
+  EXPECT_TRUE(std::equal(gold.begin(), gold.end(), v.begin(), end));
+}
+
+TEST_F(HostParallelExecutionPolicy, TestHostReduceByKey) {
+  std::vector<int> keys(size), values(size, 1);
+  for (size_t i = 0; i < size; i++) {
+    // runs of 1, 2, ..., 999 equal keys
+    keys[i] = int(std::sqrt(2.0 * i));
+  }
+  std::vector<int> keys_out(size), values_out(size);
+
+  sycl::host_parallel_execution_policy hp;
+  auto end = hp.reduce_by_key(keys.begin(), keys.end(), values.begin(),
+                              keys_out.begin(), values_out.begin());
+
+  size_t runs = 0;
+  for (size_t i = 0; i < size; runs++) {
+    size_t j = i;
+    while (j < size && keys[j] == keys[i]) {
+      j++;
+    }
+    ASSERT_EQ(keys[i], keys_out[runs]);
+    ASSERT_EQ(int(j - i), values_out[runs]);
+    i = j;
+  }
+  EXPECT_EQ(keys_out.begin() + runs, end.first);
+  EXPECT_EQ(values_out.begin() + runs, end.second);
+}
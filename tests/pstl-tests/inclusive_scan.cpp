@@ -35,6 +35,8 @@
 
 #include <sycl/helpers/sycl_usm_vector.hpp>
 
+#include "wide_value.hpp"
+
 using namespace std::experimental::parallel;
 
 struct InclusiveScanAlgorithm : public testing::Test {};
@@ -246,3 +248,17 @@ TEST_F(InclusiveScanAlgorithm, TestSyclInclusiveScanNonPowerOfTwoRange) {
     EXPECT_TRUE(std::equal(v.begin(), v.end(), gold.begin()));
   }
 }
+
+TEST_F(InclusiveScanAlgorithm, TestSyclInclusiveScanWideType) {
+  std::vector<long> gold;
+  auto v = make_wide_values(300, 10, gold);
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class InclusiveScanAlgorithmWide> snp(q);
+  inclusive_scan(snp, v.begin(), v.end(), v.begin(), wide_value_plus(),
+                 make_wide_value(10));
+
+  for (size_t i = 0; i < gold.size(); i++) {
+    EXPECT_EQ(gold[i], v[i].value);
+  }
+}
@@ -181,3 +181,54 @@ TEST_F(InnerProductAlgorithm, TestSycl8InnerProduct) {
 
   EXPECT_TRUE( (128*2) == value);
 }
+
+TEST_F(InnerProductAlgorithm, TestSyclInnerProductNonPowerOfTwo) {
+  const int n_elems = 100003;
+  sycl::helpers::usm_vector<int> v1(n_elems);
+  sycl::helpers::usm_vector<int> v2(n_elems);
+  for (int i = 0; i < n_elems; i++) {
+    v1[i] = i % 7;
+    v2[i] = i % 5 - 2;
+  }
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class SYCLInnerProductNonPowerOfTwo> snp(q);
+  // aligned, then misaligned starts and a short range with only a tail
+  for (int offset : {0, 1, 3}) {
+    for (int size : {n_elems - offset, 3}) {
+      int expected = std::inner_product(v1.begin() + offset,
+                                        v1.begin() + offset + size,
+                                        v2.begin() + offset, 10);
+      int value = inner_product(snp, v1.begin() + offset,
+                                v1.begin() + offset + size,
+                                v2.begin() + offset, 10);
+      EXPECT_EQ(expected, value);
+    }
+  }
+}
+
+TEST_F(InnerProductAlgorithm, TestSyclInnerProductMisalignedStarts) {
+  const int n_elems = 10007;
+  sycl::helpers::usm_vector<int> v1(n_elems);
+  sycl::helpers::usm_vector<int> v2(n_elems);
+  for (int i = 0; i < n_elems; i++) {
+    v1[i] = i % 7;
+    v2[i] = i % 5 - 2;
+  }
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class SYCLInnerProductMisalignedStarts> snp(q);
+  // starts reaching the pack alignment together or never
+  for (int offset1 : {1, 2, 5}) {
+    for (int offset2 : {1, 2}) {
+      const int size = n_elems - 5;
+      int expected = std::inner_product(v1.begin() + offset1,
+                                        v1.begin() + offset1 + size,
+                                        v2.begin() + offset2, 10);
+      int value = inner_product(snp, v1.begin() + offset1,
+                                v1.begin() + offset1 + size,
+                                v2.begin() + offset2, 10);
+      EXPECT_EQ(expected, value);
+    }
+  }
+}
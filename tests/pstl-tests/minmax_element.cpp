@@ -0,0 +1,59 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <experimental/algorithm>
+#include <sycl/execution_policy>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+namespace parallel = std::experimental::parallel;
+
+struct MinMaxElementAlgorithm : public testing::Test {};
+
+TEST_F(MinMaxElementAlgorithm, TestSyclMinElement) {
+  const size_t size = 100000;
+  sycl::helpers::usm_vector<int> v(size);
+  // few distinct values, so that ties have to be broken
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 50; });
+
+  sycl::sycl_execution_policy<class MinElementAlgorithm> snp;
+  auto result = parallel::min_element(snp, v.begin(), v.end());
+
+  EXPECT_EQ(std::min_element(v.begin(), v.end()), result);
+}
+
+TEST_F(MinMaxElementAlgorithm, TestSyclMaxElementComp) {
+  const size_t size = 77777;
+  sycl::helpers::usm_vector<int> v(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 50; });
+  auto comp = [](int a, int b) { return (a % 7) < (b % 7); };
+
+  sycl::sycl_execution_policy<class MaxElementAlgorithm> snp;
+  auto result = parallel::max_element(snp, v.begin(), v.end(), comp);
+
+  EXPECT_EQ(std::max_element(v.begin(), v.end(), comp), result);
+}
+
+TEST_F(MinMaxElementAlgorithm, TestSyclMinMaxElement) {
+  const size_t size = 123457;
+  sycl::helpers::usm_vector<float> v(size);
+  std::generate(v.begin(), v.end(), [] { return float(std::rand() % 100); });
+
+  sycl::sycl_execution_policy<class MinMaxElementAlgorithm> snp;
+  auto result = parallel::minmax_element(snp, v.begin(), v.end());
+
+  EXPECT_EQ(std::minmax_element(v.begin(), v.end()), result);
+}
+
+TEST_F(MinMaxElementAlgorithm, TestSyclMinMaxElementEmpty) {
+  sycl::helpers::usm_vector<int> v;
+
+  sycl::sycl_execution_policy<class MinMaxElementEmptyAlgorithm> snp;
+
+  EXPECT_EQ(v.end(), parallel::min_element(snp, v.begin(), v.end()));
+  EXPECT_EQ(std::make_pair(v.end(), v.end()),
+            parallel::minmax_element(snp, v.begin(), v.end()));
+}
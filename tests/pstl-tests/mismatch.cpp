@@ -237,3 +237,39 @@ TEST_F(MismatchAlgorithm, TestMismatchBothEmpty) {
 
   EXPECT_EQ(actual, expected);
 }
+
+TEST_F(MismatchAlgorithm, TestMismatchLongWords) {
+  const size_t N = 100003;
+  sycl::helpers::usm_vector<short> v1(N);
+  sycl::helpers::usm_vector<short> v2(N);
+  for (size_t i = 0; i < N; i++) {
+    v1[i] = v2[i] = static_cast<short>(i % 1000);
+  }
+
+  sycl::sycl_execution_policy<class MismatchAlgorithmLongWords> snp{};
+  // no difference, then one in the tail, in a word and at the beginning
+  for (size_t pos : {N, N - 1, N / 2 + 1, size_t{0}}) {
+    if (pos < N) {
+      v2[pos] = -1;
+    }
+    auto expected = std::mismatch(begin(v1), end(v1), begin(v2));
+    auto actual = parallel::mismatch(snp, begin(v1), end(v1), begin(v2), end(v2));
+    EXPECT_EQ(actual, expected);
+  }
+}
+
+TEST_F(MismatchAlgorithm, TestMismatchLongMisaligned) {
+  const size_t N = 50001;
+  sycl::helpers::usm_vector<int> v1(N);
+  sycl::helpers::usm_vector<int> v2(N);
+  for (size_t i = 0; i < N; i++) {
+    v1[i] = v2[i] = static_cast<int>(i);
+  }
+  v2[N - 10] = -1;
+
+  sycl::sycl_execution_policy<class MismatchAlgorithmLongMisaligned> snp{};
+  auto expected = std::mismatch(begin(v1) + 1, end(v1), begin(v2) + 1);
+  auto actual = parallel::mismatch(snp, begin(v1) + 1, end(v1), begin(v2) + 1,
+                                   end(v2));
+  EXPECT_EQ(actual, expected);
+}
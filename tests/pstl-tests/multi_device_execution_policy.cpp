@@ -0,0 +1,127 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include <sycl/execution_policy>
+#include <sycl/multi_device_execution_policy.hpp>
+#include <experimental/algorithm>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+#include "multi_queue_helpers.hpp"
+
+namespace parallel = std::experimental::parallel;
+
+struct MultiDeviceExecutionPolicy : public testing::Test {};
+
+TEST_F(MultiDeviceExecutionPolicy, TestSyclMultiDeviceReductions) {
+  const size_t size = 300001;
+  sycl::helpers::usm_vector<int> v(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 100; });
+
+  const long sum = std::accumulate(v.begin(), v.end(), 5l);
+  const auto odd = std::count_if(v.begin(), v.end(),
+                                 [](int x) { return x % 2 == 1; });
+
+  sycl::sycl_multi_device_execution_policy<class MultiDeviceReductions> snp(
+      make_queues(3));
+  EXPECT_EQ(sum, parallel::reduce(snp, v.begin(), v.end(), 5l,
+                                  [](long a, long b) { return a + b; }));
+  EXPECT_EQ(2 * (sum - 5) + 5,
+            snp.transform_reduce(v.begin(), v.end(),
+                                 [](int x) { return 2l * x; }, 5l,
+                                 [](long a, long b) { return a + b; }));
+  EXPECT_EQ(odd, snp.count_if(v.begin(), v.end(),
+                              [](int x) { return x % 2 == 1; }));
+}
+
+TEST_F(MultiDeviceExecutionPolicy, TestSyclMultiDeviceBinaryReductions) {
+  const size_t size = 300001;
+  sycl::helpers::usm_vector<int> v(size), w(size);
+  std::iota(v.begin(), v.end(), 0);
+  std::generate(w.begin(), w.end(), [] { return std::rand() % 4; });
+  const long dot = std::inner_product(v.begin(), v.end(), w.begin(), 1l);
+
+  sycl::sycl_multi_device_execution_policy<class MultiDeviceBinaryReductions>
+      snp(make_queues(3));
+  EXPECT_EQ(dot, snp.transform_reduce(v.begin(), v.end(), w.begin(), 1l,
+                                      [](long a, long b) { return a + b; },
+                                      [](int a, int b) { return long(a) * b; }));
+  EXPECT_EQ(std::count(w.begin(), w.end(), 3),
+            snp.count(w.begin(), w.end(), 3));
+}
+
+TEST_F(MultiDeviceExecutionPolicy, TestSyclMultiDeviceEmpty) {
+  sycl::helpers::usm_vector<int> v(1, 4), out(1, 9);
+
+  sycl::sycl_multi_device_execution_policy<class MultiDeviceEmpty> snp(
+      make_queues(3));
+  EXPECT_EQ(5, parallel::reduce(snp, v.begin(), v.begin(), 5,
+                                [](int a, int b) { return a + b; }));
+  EXPECT_EQ(0, snp.count(v.begin(), v.begin(), 4));
+  EXPECT_TRUE(out.begin() ==
+              snp.inclusive_scan(v.begin(), v.begin(), out.begin()));
+  EXPECT_TRUE(out.begin() ==
+              snp.exclusive_scan(v.begin(), v.begin(), out.begin(), 0));
+  snp.sort(v.begin(), v.begin());
+  snp.sort(v.begin(), v.end());
+  EXPECT_EQ(4, v[0]);
+  EXPECT_EQ(9, out[0]);
+}
+
+// the shards of a scan start from the reduction of the previous ones
+TEST_F(MultiDeviceExecutionPolicy, TestSyclMultiDeviceScans) {
+  const size_t size = 300001;
+  sycl::helpers::usm_vector<int> v(size), out(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 10; });
+
+  std::vector<int> expected(size);
+  std::inclusive_scan(v.begin(), v.end(), expected.begin(), std::plus<int>(),
+                      3);
+
+  sycl::sycl_multi_device_execution_policy<class MultiDeviceScans> snp(
+      make_queues(3));
+  snp.inclusive_scan(v.begin(), v.end(), out.begin(), std::plus<int>(), 3);
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), out.begin()));
+
+  std::exclusive_scan(v.begin(), v.end(), expected.begin(), 3);
+  snp.exclusive_scan(v.begin(), v.end(), out.begin(), 3);
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), out.begin()));
+}
+
+// the overloads without init start from an int 0, the carries must stay float
+TEST_F(MultiDeviceExecutionPolicy, TestSyclMultiDeviceFloatScan) {
+  const size_t size = 300001;
+  sycl::helpers::usm_vector<float> v(size), res(size);
+  fill_quarters(v);
+  std::vector<float> gold(size);
+  std::partial_sum(v.begin(), v.end(), gold.begin());
+
+  sycl::sycl_multi_device_execution_policy<class MultiDeviceFloatScan> snp(
+      make_queues(3));
+  snp.inclusive_scan(v.begin(), v.end(), res.begin());
+  EXPECT_TRUE(std::equal(gold.begin(), gold.end(), res.begin()));
+
+  std::fill(res.begin(), res.end(), 0.0f);
+  snp.inclusive_scan(v.begin(), v.end(), res.begin(),
+                     [](float a, float b) { return a + b; });
+  EXPECT_TRUE(std::equal(gold.begin(), gold.end(), res.begin()));
+}
+
+TEST_F(MultiDeviceExecutionPolicy, TestSyclMultiDeviceSort) {
+  const size_t size = 300001;
+  sycl::helpers::usm_vector<int> v(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 1000; });
+  std::vector<int> expected(v.begin(), v.end());
+  std::sort(expected.begin(), expected.end(), std::greater<int>());
+
+  sycl::sycl_multi_device_execution_policy<class MultiDeviceSort> snp(
+      make_queues(3));
+  parallel::sort(snp, v.begin(), v.end(), std::greater<int>());
+
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), v.begin()));
+}
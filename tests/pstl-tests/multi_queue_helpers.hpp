@@ -0,0 +1,37 @@
+#ifndef __SYCL_PSTL_TESTS_MULTI_QUEUE_HELPERS__
+#define __SYCL_PSTL_TESTS_MULTI_QUEUE_HELPERS__
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <CL/sycl.hpp>
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+/*
+ * Queues of the policies running several queues at once. They share the
+ * context of the USM allocations, so every queue can access the data.
+ */
+inline cl::sycl::queue make_queue() {
+  return cl::sycl::queue(sycl::helpers::default_context(),
+                         sycl::helpers::default_device());
+}
+
+inline std::vector<cl::sycl::queue> make_queues(size_t count) {
+  std::vector<cl::sycl::queue> queues;
+  for (size_t i = 0; i < count; i++) {
+    queues.push_back(make_queue());
+  }
+  return queues;
+}
+
+/*
+ * Fills v with random quarters, whose sums are exact whatever the order of
+ * the additions, so that the float results of the policies can be compared
+ * with the sequential ones
+ */
+inline void fill_quarters(sycl::helpers::usm_vector<float> &v) {
+  std::generate(v.begin(), v.end(), [] { return 0.25f * (std::rand() % 8); });
+}
+
+#endif  // __SYCL_PSTL_TESTS_MULTI_QUEUE_HELPERS__
@@ -0,0 +1,63 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include <sycl/execution_policy>
+#include <sycl/algorithm/multi_transform_reduce.hpp>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+struct MultiTransformReduceAlgorithm : public testing::Test {};
+
+TEST_F(MultiTransformReduceAlgorithm, TestSyclColumnStatistics) {
+  const size_t size = 100003;
+  sycl::helpers::usm_vector<int> v(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 1000 - 500; });
+
+  auto identity = [](int x) { return x; };
+  auto plus = [](long a, long b) { return a + b; };
+  auto aggregates = std::make_tuple(
+      std::make_tuple([](int) { return 1l; }, plus, 0l),
+      std::make_tuple(identity, plus, 0l),
+      std::make_tuple(identity, [](int a, int b) { return std::min(a, b); },
+                      std::numeric_limits<int>::max()),
+      std::make_tuple(identity, [](int a, int b) { return std::max(a, b); },
+                      std::numeric_limits<int>::min()),
+      std::make_tuple([](int x) { return long(x) * x; }, plus, 0l));
+
+  sycl::sycl_execution_policy<class MultiTransformReduceStats> snp;
+  auto [count, sum, min, max, sum_sq] =
+      sycl::impl::multi_transform_reduce(snp, v.begin(), v.end(), aggregates);
+
+  long expected_sum_sq = 0;
+  for (auto x : v) {
+    expected_sum_sq += long(x) * x;
+  }
+  EXPECT_EQ(long(size), count);
+  EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0l), sum);
+  EXPECT_EQ(*std::min_element(v.begin(), v.end()), min);
+  EXPECT_EQ(*std::max_element(v.begin(), v.end()), max);
+  EXPECT_EQ(expected_sum_sq, sum_sq);
+}
+
+TEST_F(MultiTransformReduceAlgorithm, TestSyclEmptyRange) {
+  sycl::helpers::usm_vector<float> v;
+
+  auto aggregates = std::make_tuple(
+      std::make_tuple([](float x) { return x; },
+                      [](float a, float b) { return a + b; }, 1.5f),
+      std::make_tuple([](float) { return 1; },
+                      [](int a, int b) { return a + b; }, 7));
+
+  sycl::sycl_execution_policy<class MultiTransformReduceEmpty> snp;
+  auto result =
+      sycl::impl::multi_transform_reduce(snp, v.begin(), v.end(), aggregates);
+
+  EXPECT_EQ(1.5f, std::get<0>(result));
+  EXPECT_EQ(7, std::get<1>(result));
+}
@@ -0,0 +1,95 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <sycl/execution_policy>
+#include <sycl/pipeline.hpp>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+struct PipelineAlgorithm : public testing::Test {};
+
+TEST_F(PipelineAlgorithm, TestSyclPipelineReduce) {
+  sycl::helpers::usm_vector<int> v(10000);
+  std::iota(v.begin(), v.end(), 0);
+
+  int expected = 5;
+  for (int x : v) {
+    int y = (x * 3) % 17;
+    if (y % 2 == 0)
+      expected += y + 1;
+  }
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class PipelineReduce> snp(q);
+  int res = sycl::make_pipeline(v.begin(), v.end())
+                .transform([](int x) { return (x * 3) % 17; })
+                .filter([](int y) { return y % 2 == 0; })
+                .transform([](int y) { return y + 1; })
+                .reduce(snp, 5, [](int a, int b) { return a + b; });
+
+  EXPECT_EQ(expected, res);
+}
+
+TEST_F(PipelineAlgorithm, TestSyclPipelineCopyFiltered) {
+  sycl::helpers::usm_vector<int> v(5000);
+  std::iota(v.begin(), v.end(), 0);
+
+  std::vector<float> gold;
+  for (int x : v) {
+    if (x % 3 == 0)
+      gold.push_back(x * 0.5f);
+  }
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class PipelineCopy> snp(q);
+  sycl::helpers::usm_vector<float> res(v.size());
+  auto end = sycl::make_pipeline(v.begin(), v.end())
+                 .filter([](int x) { return x % 3 == 0; })
+                 .transform([](int x) { return x * 0.5f; })
+                 .copy(snp, res.begin());
+
+  ASSERT_EQ(gold.size(), size_t(end - res.begin()));
+  EXPECT_TRUE(std::equal(gold.begin(), gold.end(), res.begin()));
+}
+
+TEST_F(PipelineAlgorithm, TestSyclPipelineInclusiveScan) {
+  sycl::helpers::usm_vector<int> v(3000), res(3000);
+  std::iota(v.begin(), v.end(), 0);
+
+  std::vector<int> gold(v.size());
+  int acc = 1;
+  for (size_t i = 0; i < v.size(); i++) {
+    acc += v[i] % 5;
+    gold[i] = acc;
+  }
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class PipelineScan> snp(q);
+  sycl::make_pipeline(v.begin(), v.end())
+      .transform([](int x) { return x % 5; })
+      .inclusive_scan(snp, res.begin(), [](int a, int b) { return a + b; }, 1);
+
+  EXPECT_TRUE(std::equal(gold.begin(), gold.end(), res.begin()));
+}
+
+TEST_F(PipelineAlgorithm, TestSyclPipelineForEach) {
+  sycl::helpers::usm_vector<int> v(1000);
+  std::iota(v.begin(), v.end(), 0);
+  sycl::helpers::usm_vector<int> hits(1, 0);
+  auto counter = hits.data();
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class PipelineForEach> snp(q);
+  sycl::make_pipeline(v.begin(), v.end())
+      .filter([](int x) { return x < 100; })
+      .for_each(snp, [counter](int) {
+        cl::sycl::atomic_ref<int, cl::sycl::memory_order::relaxed,
+                             cl::sycl::memory_scope::device>(*counter)
+            .fetch_add(1);
+      });
+
+  EXPECT_EQ(100, hits[0]);
+}
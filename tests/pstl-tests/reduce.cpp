@@ -35,6 +35,8 @@
 
 #include <sycl/helpers/sycl_usm_vector.hpp>
 
+#include "wide_value.hpp"
+
 using namespace std::experimental::parallel;
 
 class ReduceAlgorithm : public testing::Test {
@@ -140,3 +142,15 @@ TEST_F(ReduceAlgorithm, TestSyclReduce7) {
 
   EXPECT_EQ(resstd, ressycl);
 }
+
+TEST_F(ReduceAlgorithm, TestSyclReduceWideType) {
+  std::vector<long> scan;
+  auto v = make_wide_values(300, 10, scan);
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class ReduceWideAlgorithm> snp(q);
+  wide_value ressycl = reduce(snp, v.begin(), v.end(), make_wide_value(10),
+                              wide_value_plus());
+
+  EXPECT_EQ(scan.back(), ressycl.value);
+}
@@ -0,0 +1,104 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include <sycl/execution_policy>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+#include <sycl/helpers/sycl_device_pointer.hpp>
+#include <sycl/helpers/sycl_device_future.hpp>
+
+#include "wide_value.hpp"
+
+struct ReduceAsyncAlgorithm : public testing::Test {};
+
+TEST_F(ReduceAsyncAlgorithm, TestSyclReduceAsync) {
+  const size_t size = 100000;
+  sycl::helpers::usm_vector<int> v(size);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 100; });
+  int expected = std::accumulate(v.begin(), v.end(), 3);
+
+  sycl::sycl_execution_policy<class ReduceAsyncPlus> snp;
+  auto future = sycl::impl::reduce_async(snp, v.begin(), v.end(), 3,
+                                         [](int a, int b) { return a + b; });
+
+  EXPECT_EQ(expected, future.get());
+}
+
+TEST_F(ReduceAsyncAlgorithm, TestSyclReduceAsyncInFlight) {
+  const size_t size = 50000;
+  sycl::helpers::usm_vector<int> a(size), b(size);
+  std::generate(a.begin(), a.end(), [] { return std::rand() % 100; });
+  std::generate(b.begin(), b.end(), [] { return std::rand() % 100; });
+
+  sycl::sycl_execution_policy<class ReduceAsyncInFlight> snp;
+  auto plus = [](int x, int y) { return x + y; };
+  auto future_a = sycl::impl::reduce_async(snp, a.begin(), a.end(), 0, plus);
+  auto future_b = sycl::impl::reduce_async(snp, b.begin(), b.end(), 0, plus);
+
+  EXPECT_EQ(std::accumulate(b.begin(), b.end(), 0), future_b.get());
+  EXPECT_EQ(std::accumulate(a.begin(), a.end(), 0), future_a.get());
+}
+
+TEST_F(ReduceAsyncAlgorithm, TestSyclTransformReduceAsyncToDevicePointer) {
+  const size_t size = 4096;
+  sycl::helpers::usm_vector<float> v(size);
+  std::generate(v.begin(), v.end(), [] { return float(std::rand() % 10); });
+  float expected = 0.0f;
+  for (auto x : v) {
+    expected += x * x;
+  }
+
+  sycl::sycl_execution_policy<class TransformReduceAsync> snp;
+  cl::sycl::queue q = snp.get_queue();
+  float *norm = cl::sycl::malloc_device<float>(1, q);
+  auto future = sycl::impl::transform_reduce_async(
+      snp, v.begin(), v.end(), [](float x) { return x * x; }, 0.0f,
+      [](float x, float y) { return x + y; },
+      sycl::helpers::device_pointer<float>(norm));
+  future.wait();
+
+  EXPECT_EQ(norm, future.device_data().get());
+  EXPECT_FLOAT_EQ(expected, sycl::helpers::read_device_pointer(norm, q));
+  cl::sycl::free(norm, q);
+}
+
+TEST_F(ReduceAsyncAlgorithm, TestSyclInnerProductAsync) {
+  const size_t size = 3333;
+  sycl::helpers::usm_vector<int> a(size), b(size);
+  std::generate(a.begin(), a.end(), [] { return std::rand() % 10; });
+  std::generate(b.begin(), b.end(), [] { return std::rand() % 10; });
+
+  sycl::sycl_execution_policy<class InnerProductAsync> snp;
+  auto future = sycl::impl::inner_product_async(
+      snp, a.begin(), a.end(), b.begin(), 7,
+      [](int x, int y) { return x + y; }, [](int x, int y) { return x * y; });
+
+  EXPECT_EQ(std::inner_product(a.begin(), a.end(), b.begin(), 7), future.get());
+}
+
+TEST_F(ReduceAsyncAlgorithm, TestSyclReduceAsyncEmpty) {
+  sycl::helpers::usm_vector<int> v;
+
+  sycl::sycl_execution_policy<class ReduceAsyncEmpty> snp;
+  auto future = sycl::impl::reduce_async(snp, v.begin(), v.end(), 42,
+                                         [](int a, int b) { return a + b; });
+
+  EXPECT_EQ(42, future.get());
+}
+
+// accumulator too large for local memory, reduced by the chained global levels
+TEST_F(ReduceAsyncAlgorithm, TestSyclReduceAsyncWideType) {
+  std::vector<long> scan;
+  auto v = make_wide_values(300, 10, scan);
+
+  sycl::sycl_execution_policy<class ReduceAsyncWide> snp;
+  auto future = sycl::impl::reduce_async(snp, v.begin(), v.end(),
+                                         make_wide_value(10),
+                                         wide_value_plus());
+
+  EXPECT_EQ(scan.back(), future.get().value);
+}
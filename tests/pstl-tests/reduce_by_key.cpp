@@ -186,3 +186,40 @@ TEST_F(ReduceByKeyAlgorithm, reduce_by_key_float_max)
     EXPECT_TRUE(std::abs(float(values_output[2]) - 5.0f) < 1e-4f);
     EXPECT_TRUE(std::abs(float(values_output[3]) - 77.1f) < 1e-4f);
 }
+
+TEST_F(ReduceByKeyAlgorithm, reduce_by_key_random_segments)
+{
+    // segments of every length, many of them crossing work group chunks
+    size_t size = 200003;
+    sycl::helpers::usm_vector<int> keys_input(size);
+    sycl::helpers::usm_vector<int> values_input(size);
+    int key = 0;
+    for (size_t i = 0; i < size; i++) {
+        if (std::rand() % (i < size / 2 ? 3 : 3000) == 0)
+            key++;
+        keys_input[i] = key;
+        values_input[i] = std::rand() % 100;
+    }
+
+    std::vector<int> keys_expected;
+    std::vector<int> values_expected;
+    for (size_t i = 0; i < size; i++) {
+        if (i == 0 || keys_input[i] != keys_input[i - 1]) {
+            keys_expected.push_back(keys_input[i]);
+            values_expected.push_back(values_input[i]);
+        } else {
+            values_expected.back() += values_input[i];
+        }
+    }
+
+    sycl::helpers::usm_vector<int> keys_output(size);
+    sycl::helpers::usm_vector<int> values_output(size);
+    auto ends = sycl::impl::reduce_by_key(exec,
+                                          keys_input.begin(), keys_input.end(), values_input.begin(),
+                                          keys_output.begin(), values_output.begin());
+
+    EXPECT_EQ(keys_expected.size(), static_cast<size_t>(ends.first - keys_output.begin()));
+    EXPECT_EQ(values_expected.size(), static_cast<size_t>(ends.second - values_output.begin()));
+    EXPECT_TRUE(std::equal(keys_expected.begin(), keys_expected.end(), begin(keys_output)));
+    EXPECT_TRUE(std::equal(values_expected.begin(), values_expected.end(), begin(values_output)));
+}
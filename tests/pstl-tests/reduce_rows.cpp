@@ -0,0 +1,118 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include <sycl/execution_policy>
+#include <sycl/algorithm/reduce_rows.hpp>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+#include "wide_value.hpp"
+
+struct ReduceRowsAlgorithm : public testing::Test {};
+
+TEST_F(ReduceRowsAlgorithm, TestSyclReduceRows) {
+  const size_t rows = 1000, cols = 37, stride = 40;
+  sycl::helpers::usm_vector<int> matrix(rows * stride);
+  std::generate(matrix.begin(), matrix.end(), [] { return std::rand() % 100; });
+  sycl::helpers::usm_vector<int> result(rows);
+
+  sycl::sycl_execution_policy<class ReduceRowsSum> snp;
+  auto result_end = sycl::impl::reduce_rows(snp, matrix.begin(), rows, cols,
+                                            stride, result.begin(), 1,
+                                            std::plus<int>());
+
+  EXPECT_EQ(result.end(), result_end);
+  for (size_t row = 0; row < rows; row++) {
+    auto row_begin = matrix.begin() + row * stride;
+    EXPECT_EQ(std::accumulate(row_begin, row_begin + cols, 1), result[row]);
+  }
+}
+
+TEST_F(ReduceRowsAlgorithm, TestSyclReduceRowsLong) {
+  const size_t rows = 3, cols = 10001;
+  sycl::helpers::usm_vector<int> matrix(rows * cols);
+  std::generate(matrix.begin(), matrix.end(), std::rand);
+  sycl::helpers::usm_vector<int> result(rows);
+
+  sycl::sycl_execution_policy<class ReduceRowsMax> snp;
+  sycl::impl::reduce_rows(snp, matrix.begin(), rows, cols, cols,
+                          result.begin(), 0,
+                          [](int a, int b) { return std::max(a, b); });
+
+  for (size_t row = 0; row < rows; row++) {
+    auto row_begin = matrix.begin() + row * cols;
+    EXPECT_EQ(*std::max_element(row_begin, row_begin + cols), result[row]);
+  }
+}
+
+TEST_F(ReduceRowsAlgorithm, TestSyclReduceCols) {
+  const size_t rows = 513, cols = 5, stride = 7;
+  sycl::helpers::usm_vector<int> matrix(rows * stride);
+  std::generate(matrix.begin(), matrix.end(), [] { return std::rand() % 100; });
+  sycl::helpers::usm_vector<int> result(cols);
+
+  sycl::sycl_execution_policy<class ReduceColsSum> snp;
+  auto result_end = sycl::impl::reduce_cols(snp, matrix.begin(), rows, cols,
+                                            stride, result.begin(), 0,
+                                            std::plus<int>());
+
+  EXPECT_EQ(result.end(), result_end);
+  for (size_t col = 0; col < cols; col++) {
+    int expected = 0;
+    for (size_t row = 0; row < rows; row++) {
+      expected += matrix[row * stride + col];
+    }
+    EXPECT_EQ(expected, result[col]);
+  }
+}
+
+TEST_F(ReduceRowsAlgorithm, TestSyclReduceColsWide) {
+  const size_t rows = 17, cols = 1003;
+  sycl::helpers::usm_vector<int> matrix(rows * cols);
+  std::generate(matrix.begin(), matrix.end(), [] { return std::rand() % 100; });
+  sycl::helpers::usm_vector<int> result(cols);
+
+  sycl::sycl_execution_policy<class ReduceColsWide> snp;
+  sycl::impl::reduce_cols(snp, matrix.begin(), rows, cols, cols,
+                          result.begin(), 0, std::plus<int>());
+
+  for (size_t col = 0; col < cols; col++) {
+    int expected = 0;
+    for (size_t row = 0; row < rows; row++) {
+      expected += matrix[row * cols + col];
+    }
+    EXPECT_EQ(expected, result[col]);
+  }
+}
+
+// the partials of wide values do not fit in local memory
+TEST_F(ReduceRowsAlgorithm, TestSyclReduceRowsWideValue) {
+  const size_t rows = 3, cols = 5;
+  std::vector<long> scan;
+  auto matrix = make_wide_values(rows * cols, 0, scan);
+  sycl::helpers::usm_vector<wide_value> result(rows), col_result(cols);
+
+  sycl::sycl_execution_policy<class ReduceRowsWideValue> snp;
+  sycl::impl::reduce_rows(snp, matrix.begin(), rows, cols, cols,
+                          result.begin(), make_wide_value(1),
+                          wide_value_plus());
+  sycl::impl::reduce_cols(snp, matrix.begin(), rows, cols, cols,
+                          col_result.begin(), make_wide_value(1),
+                          wide_value_plus());
+
+  for (size_t row = 0; row < rows; row++) {
+    const long before = (row > 0) ? scan[row * cols - 1] : 0;
+    EXPECT_EQ(1 + scan[(row + 1) * cols - 1] - before, result[row].value);
+  }
+  for (size_t col = 0; col < cols; col++) {
+    long expected = 1;
+    for (size_t row = 0; row < rows; row++) {
+      expected += matrix[row * cols + col].value;
+    }
+    EXPECT_EQ(expected, col_result[col].value);
+  }
+}
@@ -0,0 +1,92 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+#include <experimental/algorithm>
+#include <sycl/execution_policy>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+namespace parallel = std::experimental::parallel;
+
+struct RemoveAlgorithm : public testing::Test {};
+
+TEST_F(RemoveAlgorithm, TestSyclRemove) {
+  sycl::helpers::usm_vector<int> v = {1, 2, 3, 2, 5, 2, 7, 8};
+  std::vector<int> expected(v.begin(), v.end());
+  auto expected_end = std::remove(begin(expected), end(expected), 2);
+
+  sycl::sycl_execution_policy<class RemoveValueAlgorithm> snp;
+  auto result_end = parallel::remove(snp, begin(v), end(v), 2);
+
+  EXPECT_EQ(std::distance(begin(expected), expected_end),
+            std::distance(begin(v), result_end));
+  EXPECT_TRUE(std::equal(begin(v), result_end, begin(expected)));
+}
+
+TEST_F(RemoveAlgorithm, TestSyclRemoveIfLong) {
+  const size_t size = (1 << 20) + 3;
+  sycl::helpers::usm_vector<int> v(size);
+  std::generate(v.begin(), v.end(), std::rand);
+  std::vector<int> expected(v.begin(), v.end());
+  auto predicate = [](int x) { return x % 3 == 0; };
+  auto expected_end = std::remove_if(begin(expected), end(expected), predicate);
+
+  sycl::sycl_execution_policy<class RemoveIfLongAlgorithm> snp;
+  auto result_end = parallel::remove_if(snp, begin(v), end(v), predicate);
+
+  EXPECT_EQ(std::distance(begin(expected), expected_end),
+            std::distance(begin(v), result_end));
+  EXPECT_TRUE(std::equal(begin(v), result_end, begin(expected)));
+}
+
+TEST_F(RemoveAlgorithm, TestSyclRemoveIfNone) {
+  sycl::helpers::usm_vector<int> v = {1, 3, 5, 7, 9};
+  std::vector<int> expected(v.begin(), v.end());
+
+  sycl::sycl_execution_policy<class RemoveIfNoneAlgorithm> snp;
+  auto result_end = parallel::remove_if(snp, begin(v), end(v),
+                                        [](int x) { return x % 2 == 0; });
+
+  EXPECT_EQ(end(v), result_end);
+  EXPECT_TRUE(std::equal(begin(v), end(v), begin(expected)));
+}
+
+TEST_F(RemoveAlgorithm, TestSyclRemoveCopyIf) {
+  const size_t size = 100000;
+  sycl::helpers::usm_vector<int> input(size), output(size);
+  std::generate(input.begin(), input.end(), std::rand);
+  std::vector<int> expected(size);
+  auto predicate = [](int x) { return x % 2 == 0; };
+  auto expected_end = std::remove_copy_if(begin(input), end(input),
+                                          begin(expected), predicate);
+
+  sycl::sycl_execution_policy<class RemoveCopyIfAlgorithm> snp;
+  auto result_end = parallel::remove_copy_if(snp, begin(input), end(input),
+                                             begin(output), predicate);
+
+  EXPECT_EQ(std::distance(begin(expected), expected_end),
+            std::distance(begin(output), result_end));
+  EXPECT_TRUE(std::equal(begin(output), result_end, begin(expected)));
+}
+
+TEST_F(RemoveAlgorithm, TestSyclRemoveCopyOverlapping) {
+  const size_t size = 100000;
+  sycl::helpers::usm_vector<int> v(size + 10);
+  std::generate(v.begin(), v.end(), [] { return std::rand() % 4; });
+  std::vector<int> expected(size);
+  auto expected_end = std::remove_copy(v.begin(), v.begin() + size,
+                                       begin(expected), 1);
+
+  // the destination starts inside the source range
+  sycl::sycl_execution_policy<class RemoveCopyOverlappingAlgorithm> snp;
+  auto result_end = parallel::remove_copy(snp, v.begin(), v.begin() + size,
+                                          v.begin() + 10, 1);
+
+  EXPECT_EQ(std::distance(begin(expected), expected_end),
+            std::distance(v.begin() + 10, result_end));
+  EXPECT_TRUE(std::equal(v.begin() + 10, result_end, begin(expected)));
+}
@@ -0,0 +1,71 @@
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include <sycl/execution_policy>
+#include <sycl/algorithm/scan_rows.hpp>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+#include "wide_value.hpp"
+
+struct ScanRowsAlgorithm : public testing::Test {};
+
+TEST_F(ScanRowsAlgorithm, TestSyclScanRows) {
+  const size_t rows = 300, cols = 45, stride = 48;
+  sycl::helpers::usm_vector<int> matrix(rows * stride);
+  std::generate(matrix.begin(), matrix.end(), [] { return std::rand() % 100; });
+  sycl::helpers::usm_vector<int> result(rows * stride);
+
+  sycl::sycl_execution_policy<class ScanRowsSum> snp;
+  sycl::impl::scan_rows(snp, matrix.begin(), rows, cols, stride,
+                        result.begin(), std::plus<int>());
+
+  std::vector<int> expected(cols);
+  for (size_t row = 0; row < rows; row++) {
+    auto row_begin = matrix.begin() + row * stride;
+    std::partial_sum(row_begin, row_begin + cols, expected.begin());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(),
+                           result.begin() + row * stride));
+  }
+}
+
+TEST_F(ScanRowsAlgorithm, TestSyclScanRowsInPlace) {
+  const size_t rows = 2, cols = 5000;
+  sycl::helpers::usm_vector<int> matrix(rows * cols);
+  std::generate(matrix.begin(), matrix.end(), [] { return std::rand() % 100; });
+  std::vector<int> expected(matrix.begin(), matrix.end());
+  for (size_t row = 0; row < rows; row++) {
+    auto row_begin = expected.begin() + row * cols;
+    std::partial_sum(row_begin, row_begin + cols, row_begin);
+  }
+
+  sycl::sycl_execution_policy<class ScanRowsInPlace> snp;
+  sycl::impl::scan_rows(snp, matrix.begin(), rows, cols, cols, matrix.begin(),
+                        std::plus<int>());
+
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), matrix.begin()));
+}
+
+// the tiles of wide values do not fit in local memory
+TEST_F(ScanRowsAlgorithm, TestSyclScanRowsWideValue) {
+  const size_t rows = 3, cols = 5;
+  std::vector<long> scan;
+  auto matrix = make_wide_values(rows * cols, 0, scan);
+  sycl::helpers::usm_vector<wide_value> result(rows * cols);
+
+  sycl::sycl_execution_policy<class ScanRowsWideValue> snp;
+  sycl::impl::scan_rows(snp, matrix.begin(), rows, cols, cols, result.begin(),
+                        wide_value_plus());
+
+  for (size_t row = 0; row < rows; row++) {
+    const long before = (row > 0) ? scan[row * cols - 1] : 0;
+    for (size_t col = 0; col < cols; col++) {
+      EXPECT_EQ(scan[row * cols + col] - before,
+                result[row * cols + col].value);
+    }
+  }
+}
@@ -68,3 +68,26 @@ TEST_F(TransformReduceAlgorithm, TestSyclTransformReduce2) {
 
   EXPECT_TRUE( (2*128) == ressycl);
 }
+
+TEST_F(TransformReduceAlgorithm, TestSyclTransformReduceBinary) {
+  const int n = 10007;
+  sycl::helpers::usm_vector<int> v1(n);
+  sycl::helpers::usm_vector<int> v2(n);
+  for (int i = 0; i < n; i++) {
+    v1[i] = i % 13;
+    v2[i] = i % 11;
+  }
+
+  cl::sycl::queue q;
+  sycl::sycl_execution_policy<class TransformReduceBinaryAlgorithm> snp(q);
+  // sum of absolute differences
+  int ressycl = transform_reduce(snp, v1.begin(), v1.end(), v2.begin(), 5,
+                                 [=](int a, int b) { return a + b; },
+                                 [=](int a, int b) { return a > b ? a - b : b - a; });
+
+  int expected = 5;
+  for (int i = 0; i < n; i++) {
+    expected += std::abs(v1[i] - v2[i]);
+  }
+  EXPECT_EQ(expected, ressycl);
+}
@@ -0,0 +1,49 @@
+#ifndef __SYCL_PSTL_TESTS_WIDE_VALUE__
+#define __SYCL_PSTL_TESTS_WIDE_VALUE__
+
+#include <cstdlib>
+#include <vector>
+
+#include <sycl/helpers/sycl_usm_vector.hpp>
+
+/*
+ * Value too large for the local memory of a work-group, which the reductions
+ * and scans handle in global memory
+ */
+struct wide_value {
+  long value;
+  char padding[96 * 1024];
+};
+
+inline wide_value make_wide_value(long value) {
+  wide_value w;
+  w.value = value;
+  return w;
+}
+
+// addition of the values
+struct wide_value_plus {
+  wide_value operator()(wide_value x, const wide_value &y) const {
+    x.value += y.value;
+    return x;
+  }
+};
+
+/*
+ * ``n`` wide values with random values, and the inclusive scan of their
+ * values starting from ``init`` in ``scan``
+ */
+inline sycl::helpers::usm_vector<wide_value> make_wide_values(
+    size_t n, long init, std::vector<long> &scan) {
+  sycl::helpers::usm_vector<wide_value> v(n);
+  scan.resize(n);
+  long acc = init;
+  for (size_t i = 0; i < n; i++) {
+    v[i].value = std::rand() % 100;
+    acc += v[i].value;
+    scan[i] = acc;
+  }
+  return v;
+}
+
+#endif  // __SYCL_PSTL_TESTS_WIDE_VALUE__